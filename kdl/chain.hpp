@@ -23,6 +23,7 @@
 #define KDL_CHAIN_HPP
 
 #include "segment.hpp"
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -119,6 +120,13 @@ namespace KDL {
         return true;
     }
 
+    /**
+     * Reference-counted handle to an immutable chain. Solvers constructed
+     * from the same handle share one Chain instead of each keeping a copy
+     * of all its segments.
+     */
+    typedef std::shared_ptr<const Chain> ChainConstPtr;
+
 }//end of namespace KDL
 
 #endif
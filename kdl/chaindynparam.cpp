@@ -27,18 +27,26 @@
 namespace KDL {
 
     ChainDynParam::ChainDynParam(const Chain& _chain, Vector _grav):
-            chain(_chain),
+            ChainDynParam(std::make_shared<const Chain>(_chain), _grav)
+    {
+    }
+
+    ChainDynParam::ChainDynParam(const ChainConstPtr& _chain, Vector _grav):
+            chain_ptr(_chain),
+            chain(*chain_ptr),
             nr(0),
             nj(chain.getNrOfJoints()),
             ns(chain.getNrOfSegments()),
             grav(_grav),
             jntarraynull(nj),
-            chainidsolver_coriolis( chain, Vector::Zero()),
-            chainidsolver_gravity( chain, grav),
+            chainidsolver_coriolis( chain_ptr, Vector::Zero()),
+            gravitysolver( chain_ptr, grav),
             wrenchnull(ns,Wrench::Zero()),
             X(ns),
             S(ns),
-            Ic(ns)
+            Ic(ns),
+            f_cor(ns),
+            f_grav(ns)
     {
         ag=-Twist(grav,Vector::Zero());
     }
@@ -48,17 +56,20 @@ namespace KDL {
         ns = chain.getNrOfSegments();
         jntarraynull.resize(nj);
         chainidsolver_coriolis.updateInternalDataStructures();
-        chainidsolver_gravity.updateInternalDataStructures();
+        gravitysolver.updateInternalDataStructures();
         wrenchnull.resize(ns,Wrench::Zero());
         X.resize(ns);
         S.resize(ns);
         Ic.resize(ns);
+        f_cor.resize(ns);
+        f_grav.resize(ns);
     }
 
 
     //calculate inertia matrix H
     int ChainDynParam::JntToMass(const JntArray &q, JntSpaceInertiaMatrix& H)
     {
+        KDL_SOLVER_TELEMETRY_SCOPE();
         if(nj != chain.getNrOfJoints() || ns != chain.getNrOfSegments())
             return (error = E_NOT_UP_TO_DATE);
 	//Check sizes when in debug mode
@@ -84,9 +95,16 @@ namespace KDL {
 	  X[i]=chain.getSegment(i).pose(q_);//Remark this is the inverse of the frame for transformations from the parent to the current coord frame
 	  S[i]=X[i].M.Inverse(chain.getSegment(i).twist(q_,1.0));
         }
+        compositeInertia(H);
+	return (error = E_NOERROR);
+    }
+
+    //Composite rigid body algorithm, from X, S and the rigid body inertias in Ic
+    void ChainDynParam::compositeInertia(JntSpaceInertiaMatrix& H)
+    {
 	//Sweep from leaf to root
         int j,l;
-	k=nj-1; //reset k
+	std::size_t k=nj-1; //reset k
         for(int i=ns-1;i>=0;i--)
 	{
 
@@ -120,30 +138,84 @@ namespace KDL {
 	  }
 
 	}
-	return (error = E_NOERROR);
+    }
+
+    int ChainDynParam::JntToDynamics(const JntArray &q, const JntArray &q_dot, JntSpaceInertiaMatrix& H, JntArray &coriolis, JntArray &gravity)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        if(nj != chain.getNrOfJoints() || ns != chain.getNrOfSegments())
+            return (error = E_NOT_UP_TO_DATE);
+        if(q.rows()!=nj || q_dot.rows()!=nj || H.rows()!=nj || H.columns()!=nj || coriolis.rows()!=nj || gravity.rows()!=nj)
+            return (error = E_SIZE_MISMATCH);
+
+        //Sweep from root to leaf: the kinematics, shared by the three terms,
+        //and the forces of the recursive Newton-Euler runs of JntToCoriolis and JntToGravity
+        std::size_t k=0;
+        Twist v,a_cor,a_grav;
+        for(std::size_t i=0;i<ns;i++){
+            const Segment& segment=chain.getSegment(i);
+            double q_,qdot_;
+            if(segment.getJoint().getType()!=Joint::Fixed){
+                q_=q(k);
+                qdot_=q_dot(k);
+                k++;
+            }else
+                q_=qdot_=0.0;
+
+            X[i]=segment.pose(q_);
+            S[i]=X[i].M.Inverse(segment.twist(q_,1.0));
+            Twist vj=S[i]*qdot_;
+            if(i==0){
+                v=vj;
+                a_cor=v*vj;
+                a_grav=X[i].Inverse(ag);
+            }else{
+                v=X[i].Inverse(v)+vj;
+                a_cor=X[i].Inverse(a_cor)+v*vj;
+                a_grav=X[i].Inverse(a_grav);
+            }
+            const RigidBodyInertia& Ii=segment.getInertia();
+            Ic[i]=Ii;
+            f_cor[i]=Ii*a_cor+v*(Ii*v);
+            f_grav[i]=Ii*a_grav;
+        }
+
+        //Sweep from leaf to root: the joint torques of both runs
+        k=nj;
+        for(int i=ns-1;i>=0;i--){
+            if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed){
+                --k;
+                coriolis(k)=dot(S[i],f_cor[i]);
+                gravity(k)=dot(S[i],f_grav[i]);
+            }
+            if(i!=0){
+                f_cor[i-1]=f_cor[i-1]+X[i]*f_cor[i];
+                f_grav[i-1]=f_grav[i-1]+X[i]*f_grav[i];
+            }
+        }
+
+        compositeInertia(H);
+        return (error = E_NOERROR);
     }
 
     //calculate coriolis matrix C
     int ChainDynParam::JntToCoriolis(const JntArray &q, const JntArray &q_dot, JntArray &coriolis)
     {
+	KDL_SOLVER_TELEMETRY_SCOPE();
     //make a null matrix with the size of q_dotdot and a null wrench
 	SetToZero(jntarraynull);
 
 
 	//the calculation of coriolis matrix C
-	return chainidsolver_coriolis.CartToJnt(q, q_dot, jntarraynull, wrenchnull, coriolis);
+	return (error = chainidsolver_coriolis.CartToJnt(q, q_dot, jntarraynull, wrenchnull, coriolis));
 
     }
 
     //calculate gravity matrix G
     int ChainDynParam::JntToGravity(const JntArray &q,JntArray &gravity)
     {
-
-	//make a null matrix with the size of q_dotdot and a null wrench
-
-	SetToZero(jntarraynull);
-	//the calculation of coriolis matrix C
-	return chainidsolver_gravity.CartToJnt(q, jntarraynull, jntarraynull, wrenchnull, gravity);
+	KDL_SOLVER_TELEMETRY_SCOPE();
+	return (error = gravitysolver.JntToGravity(q, gravity));
     }
 
     ChainDynParam::~ChainDynParam()
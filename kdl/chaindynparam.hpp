@@ -23,6 +23,7 @@
 #define KDLCHAINDYNPARAM_HPP
 
 #include "chainidsolver_recursive_newton_euler.hpp"
+#include "chainjnttogravitysolver.hpp"
 #include "articulatedbodyinertia.hpp"
 #include "jntspaceinertiamatrix.hpp"
 #include <Eigen/StdVector>
@@ -48,17 +49,37 @@ namespace KDL {
     {
     public:
         ChainDynParam(const Chain& chain, Vector _grav);
+        /// Constructor sharing \a chain with the internal solvers instead of copying it.
+        ChainDynParam(const ChainConstPtr& chain, Vector _grav);
         virtual ~ChainDynParam();
 
         virtual int JntToCoriolis(const JntArray &q, const JntArray &q_dot, JntArray &coriolis);
 	virtual int JntToMass(const JntArray &q, JntSpaceInertiaMatrix& H);
 	virtual int JntToGravity(const JntArray &q,JntArray &gravity);
 
+        /**
+         * Calculates the results of JntToMass, JntToCoriolis and JntToGravity
+         * in one call, computing the poses and motion subspaces of the
+         * segments once.  Does not allocate memory.
+         *
+         * @param q joint positions
+         * @param q_dot joint velocities
+         * @param H output joint space inertia matrix
+         * @param coriolis output Coriolis and centrifugal torques C(q,q_dot)*q_dot
+         * @param gravity output gravity torques
+         * @return E_NOERROR, E_NOT_UP_TO_DATE or E_SIZE_MISMATCH
+         */
+        virtual int JntToDynamics(const JntArray &q, const JntArray &q_dot, JntSpaceInertiaMatrix& H,
+                                  JntArray &coriolis, JntArray &gravity);
+
     /// @copydoc KDL::SolverI::updateInternalDataStructures()
     virtual void updateInternalDataStructures();
 
     private:
-        const Chain chain;
+        void compositeInertia(JntSpaceInertiaMatrix& H);
+
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
 	int nr;  // unused, remove in a future version
 	std::size_t nj;
         std::size_t ns;	
@@ -66,12 +87,14 @@ namespace KDL {
 	Vector vectornull;
 	JntArray jntarraynull;
 	ChainIdSolver_RNE chainidsolver_coriolis;
-	ChainIdSolver_RNE chainidsolver_gravity;
+	ChainJntToGravitySolver gravitysolver;
 	std::vector<Wrench> wrenchnull;
         std::vector<Frame> X;
         std::vector<Twist> S;
         //std::vector<RigidBodyInertia> I;
         std::vector<ArticulatedBodyInertia, Eigen::aligned_allocator<ArticulatedBodyInertia> > Ic;
+        std::vector<Wrench> f_cor;
+        std::vector<Wrench> f_grav;
         Wrench F;
         Twist ag;
 	
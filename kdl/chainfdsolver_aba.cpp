@@ -0,0 +1,156 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainfdsolver_aba.hpp"
+
+namespace KDL{
+
+    ChainFdSolver_ABA::ChainFdSolver_ABA(const Chain& chain_, Vector grav):
+        ChainFdSolver_ABA(std::make_shared<const Chain>(chain_), grav)
+    {
+    }
+
+    ChainFdSolver_ABA::ChainFdSolver_ABA(const ChainConstPtr& chain_, Vector grav):
+        chain_ptr(chain_), chain(*chain_ptr), nj(chain.getNrOfJoints()), ns(chain.getNrOfSegments()),
+        X(ns), S(ns), v(ns), c(ns), a(ns), IA(ns), pA(ns), U(ns), D(ns), u(ns), passive(nj)
+    {
+        ag=-Twist(grav,Vector::Zero());
+    }
+
+    void ChainFdSolver_ABA::updateInternalDataStructures() {
+        nj = chain.getNrOfJoints();
+        ns = chain.getNrOfSegments();
+        X.resize(ns);
+        S.resize(ns);
+        v.resize(ns);
+        c.resize(ns);
+        a.resize(ns);
+        IA.resize(ns);
+        pA.resize(ns);
+        U.resize(ns);
+        D.resize(ns);
+        u.resize(ns);
+        passive.resize(nj);
+    }
+
+    int ChainFdSolver_ABA::CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &torques, const Wrenches& f_ext, JntArray &q_dotdot)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        if(f_ext.size()!=ns)
+            return (error = E_SIZE_MISMATCH);
+        return (error = solve(q, q_dot, torques, &f_ext, q_dotdot));
+    }
+
+    int ChainFdSolver_ABA::CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &torques, JntArray &q_dotdot)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        return (error = solve(q, q_dot, torques, NULL, q_dotdot));
+    }
+
+    int ChainFdSolver_ABA::solve(const JntArray &q, const JntArray &q_dot, const JntArray &torques, const Wrenches* f_ext, JntArray &q_dotdot)
+    {
+        if(nj != chain.getNrOfJoints() || ns != chain.getNrOfSegments())
+            return E_NOT_UP_TO_DATE;
+
+        if(q.rows()!=nj || q_dot.rows()!=nj || q_dotdot.rows()!=nj || torques.rows()!=nj)
+            return E_SIZE_MISMATCH;
+        if(torque_model){
+            const int rc=torque_model->JntToTorque(q, q_dot, passive);
+            if(rc < 0)
+                return rc;
+        }
+
+        //Sweep from root to leaf: velocities, velocity product accelerations
+        //and rigid body bias forces, all in segment coordinates
+        std::size_t j=0;
+        for(std::size_t i=0;i<ns;i++){
+            const Segment& segment=chain.getSegment(i);
+            double q_,qdot_;
+            if(segment.getJoint().getType()!=Joint::Fixed) {
+                q_=q(j);
+                qdot_=q_dot(j);
+                j++;
+            }else
+                q_=qdot_=0.0;
+
+            X[i]=segment.pose(q_);
+            Twist vj=X[i].M.Inverse(segment.twist(q_,qdot_));
+            S[i]=X[i].M.Inverse(segment.twist(q_,1.0));
+            if(i==0)
+                v[i]=vj;
+            else
+                v[i]=X[i].Inverse(v[i-1])+vj;
+            //cj=0, see ChainIdSolver_RNE
+            c[i]=v[i]*vj;
+
+            const RigidBodyInertia& Ii=segment.getInertia();
+            IA[i]=Ii;
+            pA[i]=v[i]*(Ii*v[i]);
+            if(f_ext)
+                pA[i]=pA[i]-(*f_ext)[i];
+        }
+
+        //Sweep from leaf to root: articulated body inertias and bias forces,
+        //each one is projected over its joint and added to the parent
+        j=nj;
+        for(int i=ns-1;i>=0;i--){
+            const Joint& joint=chain.getSegment(i).getJoint();
+            const bool moving=joint.getType()!=Joint::Fixed;
+            if(moving){
+                --j;
+                U[i]=IA[i]*S[i];
+                D[i]=dot(S[i],U[i])+joint.getInertia();
+                if(!(D[i]>0))
+                    return E_UNDEFINED;
+                u[i]=torques(j)-dot(S[i],pA[i]);
+                if(torque_model)
+                    u[i]+=passive(j);
+            }
+            if(i!=0){
+                ArticulatedBodyInertia Ia=IA[i];
+                if(moving){
+                    //Ia = IA - U*U'/D, with U=[force;torque] and IA=[M,H';H,I]
+                    Eigen::Map<const Eigen::Vector3d> Uf(U[i].force.data);
+                    Eigen::Map<const Eigen::Vector3d> Ut(U[i].torque.data);
+                    const double Dinv=1.0/D[i];
+                    Ia.M.noalias()-=Dinv*Uf*Uf.transpose();
+                    Ia.H.noalias()-=Dinv*Ut*Uf.transpose();
+                    Ia.I.noalias()-=Dinv*Ut*Ut.transpose();
+                }
+                Wrench pa=pA[i]+Ia*c[i];
+                if(moving)
+                    pa=pa+U[i]*(u[i]/D[i]);
+                IA[i-1]=IA[i-1]+X[i]*Ia;
+                pA[i-1]=pA[i-1]+X[i]*pa;
+            }
+        }
+
+        //Sweep from root to leaf: accelerations
+        j=0;
+        for(std::size_t i=0;i<ns;i++){
+            if(i==0)
+                a[i]=X[i].Inverse(ag)+c[i];
+            else
+                a[i]=X[i].Inverse(a[i-1])+c[i];
+            if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed){
+                q_dotdot(j)=(u[i]-dot(a[i],U[i]))/D[i];
+                a[i]=a[i]+S[i]*q_dotdot(j);
+                j++;
+            }
+        }
+        return E_NOERROR;
+    }
+}//namespace
@@ -0,0 +1,108 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_CHAIN_FDSOLVER_ABA_HPP
+#define KDL_CHAIN_FDSOLVER_ABA_HPP
+
+#include "chainfdsolver.hpp"
+#include "articulatedbodyinertia.hpp"
+#include "jointtorquemodel.hpp"
+
+namespace KDL{
+    /**
+     * \brief Articulated-body forward dynamics solver
+     *
+     * The algorithm implementation is based on the book "Rigid Body
+     * Dynamics Algorithms" of Roy Featherstone, 2008
+     * (ISBN:978-0-387-74314-1) See Chapter 7 for the articulated-body
+     * algorithm.
+     *
+     * It calculates the same joint accelerations as ChainFdSolver_RNE,
+     * with the same conventions (external forces on the segments expressed
+     * in the segments reference frame, joint rotor inertia included), in
+     * three sweeps over the chain: O(n) instead of forming and factoring
+     * the joint space inertia matrix.  No memory is allocated in CartToJnt.
+     *
+     * The passive torques of a JointTorqueModel set with
+     * setJointTorqueModel() are added to the applied torques.
+     */
+    class ChainFdSolver_ABA : public ChainFdSolver{
+    public:
+        /**
+         * Constructor for the solver, it will allocate all the necessary memory
+         * \param chain The kinematic chain to calculate the forward dynamics for, an internal copy will be made.
+         * \param grav The gravity vector to use during the calculation.
+         */
+        ChainFdSolver_ABA(const Chain& chain, Vector grav);
+        /**
+         * Constructor for the solver sharing \a chain instead of copying it.
+         */
+        ChainFdSolver_ABA(const ChainConstPtr& chain, Vector grav);
+        ~ChainFdSolver_ABA(){};
+
+        /**
+         * Function to calculate the joint accelerations.
+         * Input parameters;
+         * \param q The current joint positions
+         * \param q_dot The current joint velocities
+         * \param torques The current joint torques (applied by controller)
+         * \param f_ext The external forces (no gravity) on the segments
+         * Output parameters:
+         * \param q_dotdot The resulting joint accelerations
+         * \return E_UNDEFINED if the articulated inertia about a joint is not
+         * positive, e.g. for a joint that moves no mass
+         */
+        int CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &torques, const Wrenches& f_ext, JntArray &q_dotdot);
+
+        /**
+         * Same as above, without external forces.
+         */
+        int CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &torques, JntArray &q_dotdot);
+
+        /**
+         * Sets the friction, damping and elasticity of the joints, NULL
+         * (the default) for none.  \a model is shared, not copied.
+         */
+        void setJointTorqueModel(const JointTorqueModelConstPtr& model) { torque_model = model; }
+        const JointTorqueModelConstPtr& getJointTorqueModel() const { return torque_model; }
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+    private:
+        int solve(const JntArray &q, const JntArray &q_dot, const JntArray &torques, const Wrenches* f_ext, JntArray &q_dotdot);
+
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
+        std::size_t nj;
+        std::size_t ns;
+        Twist ag;
+        std::vector<Frame> X;
+        std::vector<Twist> S;
+        std::vector<Twist> v;
+        std::vector<Twist> c;
+        std::vector<Twist> a;
+        std::vector<ArticulatedBodyInertia> IA;
+        std::vector<Wrench> pA;
+        std::vector<Wrench> U;
+        std::vector<double> D;
+        std::vector<double> u;
+        JointTorqueModelConstPtr torque_model;
+        JntArray passive;
+    };
+}
+
+#endif
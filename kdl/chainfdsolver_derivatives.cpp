@@ -0,0 +1,88 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainfdsolver_derivatives.hpp"
+
+namespace KDL{
+
+    ChainFdSolver_Derivatives::ChainFdSolver_Derivatives(const Chain& chain_, Vector grav):
+        ChainFdSolver_Derivatives(std::make_shared<const Chain>(chain_), grav)
+    {
+    }
+
+    ChainFdSolver_Derivatives::ChainFdSolver_Derivatives(const ChainConstPtr& chain_, Vector grav):
+        chain_ptr(chain_), chain(*chain_ptr), nj(chain.getNrOfJoints()),
+        fdsolver(chain_ptr, grav), idsolver(chain_ptr, grav), dynparam(chain_ptr, grav),
+        H(nj), id_torques(nj), llt(nj)
+    {
+    }
+
+    void ChainFdSolver_Derivatives::setJointTorqueModel(const JointTorqueModelConstPtr& model)
+    {
+        torque_model = model;
+        fdsolver.setJointTorqueModel(model);
+        idsolver.setJointTorqueModel(model);
+    }
+
+    void ChainFdSolver_Derivatives::updateInternalDataStructures() {
+        nj = chain.getNrOfJoints();
+        fdsolver.updateInternalDataStructures();
+        idsolver.updateInternalDataStructures();
+        dynparam.updateInternalDataStructures();
+        H.resize(nj);
+        id_torques.resize(nj);
+        llt = Eigen::LLT<Eigen::MatrixXd>(nj);
+    }
+
+    int ChainFdSolver_Derivatives::CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &torques, const Wrenches& f_ext, JntArray &q_dotdot)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        return (error = fdsolver.CartToJnt(q, q_dot, torques, f_ext, q_dotdot));
+    }
+
+    int ChainFdSolver_Derivatives::CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &torques, const Wrenches& f_ext, JntArray &q_dotdot,
+                                             Eigen::MatrixXd& dq_dotdot_dq, Eigen::MatrixXd& dq_dotdot_dqdot, Eigen::MatrixXd& dq_dotdot_dtorques)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        if(nj != chain.getNrOfJoints())
+            return (error = E_NOT_UP_TO_DATE);
+        if((std::size_t)dq_dotdot_dtorques.rows()!=nj || (std::size_t)dq_dotdot_dtorques.cols()!=nj)
+            return (error = E_SIZE_MISMATCH);
+
+        error = fdsolver.CartToJnt(q, q_dot, torques, f_ext, q_dotdot);
+        if(error != E_NOERROR)
+            return error;
+        // the sizes of the derivatives are checked here, the inverse
+        // dynamics include the derivatives of the passive torques
+        error = idsolver.CartToJnt(q, q_dot, q_dotdot, f_ext, id_torques, dq_dotdot_dq, dq_dotdot_dqdot);
+        if(error != E_NOERROR)
+            return error;
+        error = dynparam.JntToMass(q, H);
+        if(error != E_NOERROR)
+            return error;
+
+        llt.compute(H.data);
+        if(llt.info() != Eigen::Success)
+            return (error = E_UNDEFINED);
+        llt.solveInPlace(dq_dotdot_dq);
+        llt.solveInPlace(dq_dotdot_dqdot);
+        dq_dotdot_dq = -dq_dotdot_dq;
+        dq_dotdot_dqdot = -dq_dotdot_dqdot;
+        dq_dotdot_dtorques.setIdentity();
+        llt.solveInPlace(dq_dotdot_dtorques);
+        return (error = E_NOERROR);
+    }
+}//namespace
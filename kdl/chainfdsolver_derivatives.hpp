@@ -0,0 +1,106 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_CHAIN_FDSOLVER_DERIVATIVES_HPP
+#define KDL_CHAIN_FDSOLVER_DERIVATIVES_HPP
+
+#include "chainfdsolver_aba.hpp"
+#include "chainidsolver_rne_derivatives.hpp"
+#include "chaindynparam.hpp"
+
+#include <Eigen/Cholesky>
+
+namespace KDL{
+    /**
+     * \brief Forward dynamics solver with the partial derivatives of the
+     * joint accelerations with respect to the joint positions, velocities
+     * and torques.
+     *
+     * The accelerations are computed by ChainFdSolver_ABA.  Differentiating
+     * torques = ID(q, q_dot, q_dotdot) at the computed accelerations gives
+     * \f$ \partial \ddot q / \partial q = -H^{-1} \partial ID / \partial q \f$,
+     * the same for q_dot, and \f$ \partial \ddot q / \partial \tau = H^{-1} \f$,
+     * with the analytical derivatives of ChainIdSolver_RNE_Derivatives and
+     * the joint space inertia matrix H of ChainDynParam.
+     *
+     * The passive torques of a JointTorqueModel set with
+     * setJointTorqueModel() are added to the applied torques, and their
+     * derivatives, see JointTorqueModel::JntToTorqueDerivatives(), to the
+     * ones of the inverse dynamics.
+     */
+    class ChainFdSolver_Derivatives : public ChainFdSolver{
+    public:
+        /**
+         * Constructor for the solver, it will allocate all the necessary memory
+         * \param chain The kinematic chain to calculate the forward dynamics for, an internal copy will be made.
+         * \param grav The gravity vector to use during the calculation.
+         */
+        ChainFdSolver_Derivatives(const Chain& chain, Vector grav);
+        /**
+         * Constructor for the solver sharing \a chain with the internal
+         * solvers instead of copying it.
+         */
+        ChainFdSolver_Derivatives(const ChainConstPtr& chain, Vector grav);
+        ~ChainFdSolver_Derivatives(){};
+
+        /**
+         * Calculates the joint accelerations only, as ChainFdSolver_ABA.
+         */
+        int CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &torques, const Wrenches& f_ext, JntArray &q_dotdot);
+
+        /**
+         * Calculates the joint accelerations and their partial derivatives.
+         * Input parameters;
+         * \param q The current joint positions
+         * \param q_dot The current joint velocities
+         * \param torques The current joint torques (applied by controller)
+         * \param f_ext The external forces (no gravity) on the segments
+         * Output parameters:
+         * \param q_dotdot The resulting joint accelerations
+         * \param dq_dotdot_dq nj x nj matrix, element (i,k) is d q_dotdot(i) / d q(k)
+         * \param dq_dotdot_dqdot nj x nj matrix, element (i,k) is d q_dotdot(i) / d q_dot(k)
+         * \param dq_dotdot_dtorques nj x nj matrix, the inverse of the joint space inertia matrix
+         * \return E_UNDEFINED if the joint space inertia matrix is not positive definite,
+         * the error of the joint torque model if it has no derivatives
+         */
+        int CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &torques, const Wrenches& f_ext, JntArray &q_dotdot,
+                      Eigen::MatrixXd& dq_dotdot_dq, Eigen::MatrixXd& dq_dotdot_dqdot, Eigen::MatrixXd& dq_dotdot_dtorques);
+
+        /**
+         * Sets the friction, damping and elasticity of the joints, NULL
+         * (the default) for none.  \a model is shared, not copied.
+         */
+        void setJointTorqueModel(const JointTorqueModelConstPtr& model);
+        const JointTorqueModelConstPtr& getJointTorqueModel() const { return torque_model; }
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+    private:
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
+        std::size_t nj;
+        ChainFdSolver_ABA fdsolver;
+        ChainIdSolver_RNE_Derivatives idsolver;
+        ChainDynParam dynparam;
+        JntSpaceInertiaMatrix H;
+        JntArray id_torques;
+        Eigen::LLT<Eigen::MatrixXd> llt;
+        JointTorqueModelConstPtr torque_model;
+    };
+}
+
+#endif
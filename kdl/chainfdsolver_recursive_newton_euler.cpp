@@ -27,9 +27,15 @@
 namespace KDL{
 
     ChainFdSolver_RNE::ChainFdSolver_RNE(const Chain& _chain, Vector _grav):
-        chain(_chain),
-        DynSolver(chain, _grav),
-        IdSolver(chain, _grav),
+        ChainFdSolver_RNE(std::make_shared<const Chain>(_chain), _grav)
+    {
+    }
+
+    ChainFdSolver_RNE::ChainFdSolver_RNE(const ChainConstPtr& _chain, Vector _grav):
+        chain_ptr(_chain),
+        chain(*chain_ptr),
+        DynSolver(chain_ptr, _grav),
+        IdSolver(chain_ptr, _grav),
         nj(chain.getNrOfJoints()),
         ns(chain.getNrOfSegments()),
         H(nj),
@@ -50,6 +56,7 @@ namespace KDL{
 
     int ChainFdSolver_RNE::CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &torques, const Wrenches& f_ext, JntArray &q_dotdot)
     {
+        KDL_SOLVER_TELEMETRY_SCOPE();
         if(nj != chain.getNrOfJoints() || ns != chain.getNrOfSegments())
             return (error = E_NOT_UP_TO_DATE);
 
@@ -109,16 +116,16 @@ namespace KDL{
         for (std::size_t i=0; i<nj; ++i)
         {
             q_temp(i) = q(i) + q_dot_temp(i)*dt/2.0;
-            q_dot_temp(i) = q_dot(i) + q_dotdot(i)*dt/2.0;
             dq(i) += 2.0*q_dot_temp(i);
+            q_dot_temp(i) = q_dot(i) + q_dotdot(i)*dt/2.0;
             dq_dot(i) += 2.0*q_dotdot(i);
         }
         fdsolver.CartToJnt(q_temp, q_dot_temp, torques, f_ext, q_dotdot);
         for (std::size_t i=0; i<nj; ++i)
         {
             q_temp(i) = q(i) + q_dot_temp(i)*dt;
-            q_dot_temp(i) = q_dot(i) + q_dotdot(i)*dt;
             dq(i) += 2.0*q_dot_temp(i);
+            q_dot_temp(i) = q_dot(i) + q_dotdot(i)*dt;
             dq_dot(i) += 2.0*q_dotdot(i);
         }
         fdsolver.CartToJnt(q_temp, q_dot_temp, torques, f_ext, q_dotdot);
@@ -38,6 +38,10 @@ namespace KDL{
      * position and velocity of the joints (q,qdot,qdotdot), external forces
      * on the segments (expressed in the segments reference frame),
      * and the dynamical parameters of the segments.
+     *
+     * The passive torques of a JointTorqueModel set with
+     * setJointTorqueModel() are added to the applied torques: the internal
+     * ChainIdSolver_RNE includes them in the torques at zero acceleration.
      */
     class ChainFdSolver_RNE : public ChainFdSolver{
     public:
@@ -47,6 +51,11 @@ namespace KDL{
          * \param grav The gravity vector to use during the calculation.
          */
         ChainFdSolver_RNE(const Chain& chain, Vector grav);
+        /**
+         * Constructor for the solver sharing \a chain with the internal
+         * dynamics solvers instead of copying it.
+         */
+        ChainFdSolver_RNE(const ChainConstPtr& chain, Vector grav);
         ~ChainFdSolver_RNE(){};
 
         /**
@@ -61,6 +70,13 @@ namespace KDL{
          */
         int CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &torques, const Wrenches& f_ext, JntArray &q_dotdot);
 
+        /**
+         * Sets the friction, damping and elasticity of the joints, NULL
+         * (the default) for none.  \a model is shared, not copied.
+         */
+        void setJointTorqueModel(const JointTorqueModelConstPtr& model) { IdSolver.setJointTorqueModel(model); }
+        const JointTorqueModelConstPtr& getJointTorqueModel() const { return IdSolver.getJointTorqueModel(); }
+
         /// @copydoc KDL::SolverI::updateInternalDataStructures
         virtual void updateInternalDataStructures();
 
@@ -85,6 +101,9 @@ namespace KDL{
          * Temporary parameters:
          * \param qtemp Intermediate joint positions
          * \param qdtemp Intermediate joint velocities
+         *
+         * ChainSimulator offers the same with owned temporaries, other
+         * integration methods and the joint damping and stiffness.
          */
         void RK4Integrator(std::size_t& nj, const double& t, double& dt, KDL::JntArray& q, KDL::JntArray& q_dot,
                            KDL::JntArray& torques, KDL::Wrenches& f_ext, KDL::ChainFdSolver_RNE& fdsolver,
@@ -92,7 +111,8 @@ namespace KDL{
                            KDL::JntArray& q_temp, KDL::JntArray& q_dot_temp);
 
     private:
-        const Chain chain;
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
         ChainDynParam DynSolver;
         ChainIdSolver_RNE IdSolver;
         std::size_t nj;
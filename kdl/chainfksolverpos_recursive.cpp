@@ -22,15 +22,35 @@
 
 #include "chainfksolverpos_recursive.hpp"
 #include <iostream>
+#include <utility>
 
 namespace KDL {
 
     ChainFkSolverPos_recursive::ChainFkSolverPos_recursive(const Chain& _chain):
-        chain(_chain)
+        ChainFkSolverPos_recursive(std::make_shared<const Chain>(_chain))
     {
     }
 
-    int ChainFkSolverPos_recursive::JntToCart(const JntArray& q_in, Frame& p_out, int seg_nr)    {
+    ChainFkSolverPos_recursive::ChainFkSolverPos_recursive(const ChainConstPtr& _chain):
+        chain_ptr(_chain),
+        chain(*chain_ptr)
+    {
+    }
+
+    int ChainFkSolverPos_recursive::JntToCart(const JntArray& q_in, Frame& p_out, int seg_nr)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        return (error = std::as_const(*this).JntToCart(q_in, p_out, seg_nr));
+    }
+
+    int ChainFkSolverPos_recursive::JntToCart(const JntArray& q_in, std::vector<Frame>& p_out, int seg_nr)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        return (error = std::as_const(*this).JntToCart(q_in, p_out, seg_nr));
+    }
+
+    int ChainFkSolverPos_recursive::JntToCart(const JntArray& q_in, Frame& p_out, int seg_nr) const
+    {
         std::size_t segmentNr;
         if(seg_nr<0)
             segmentNr=chain.getNrOfSegments();
@@ -40,9 +60,9 @@ namespace KDL {
         p_out = Frame::Identity();
 
         if(q_in.rows()!=chain.getNrOfJoints())
-            return (error = E_SIZE_MISMATCH);
+            return E_SIZE_MISMATCH;
         else if(segmentNr>chain.getNrOfSegments())
-            return (error = E_OUT_OF_RANGE);
+            return E_OUT_OF_RANGE;
         else{
             int j=0;
             for(std::size_t i=0;i<segmentNr;i++){
@@ -53,10 +73,12 @@ namespace KDL {
                     p_out = p_out*chain.getSegment(i).pose(0.0);
                 }
             }
-            return (error = E_NOERROR);
+            return E_NOERROR;
         }
     }
-    int ChainFkSolverPos_recursive::JntToCart(const JntArray& q_in, std::vector<Frame>& p_out, int seg_nr)    {
+
+    int ChainFkSolverPos_recursive::JntToCart(const JntArray& q_in, std::vector<Frame>& p_out, int seg_nr) const
+    {
         std::size_t segmentNr;
         if(seg_nr<0)
             segmentNr=chain.getNrOfSegments();
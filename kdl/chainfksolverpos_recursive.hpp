@@ -37,15 +37,29 @@ namespace KDL {
     {
     public:
         ChainFkSolverPos_recursive(const Chain& chain);
+        /// Shares the immutable \a chain with other solvers instead of copying it.
+        ChainFkSolverPos_recursive(const ChainConstPtr& chain);
         ~ChainFkSolverPos_recursive();
 
         virtual int JntToCart(const JntArray& q_in, Frame& p_out, int segmentNr=-1);
         virtual int JntToCart(const JntArray& q_in, std::vector<Frame>& p_out, int segmentNr=-1);
 
+        /**
+         * Thread-safe variants of JntToCart(): they only read the chain
+         * and do not store the latest error, so a single solver can be
+         * shared by several threads. The recursion needs no scratch
+         * memory, hence no workspace has to be passed in.
+         *
+         * @return the same error codes as the non-const variants
+         */
+        int JntToCart(const JntArray& q_in, Frame& p_out, int segmentNr=-1) const;
+        int JntToCart(const JntArray& q_in, std::vector<Frame>& p_out, int segmentNr=-1) const;
+
         virtual void updateInternalDataStructures() {};
 
     private:
-        const Chain chain;
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
     };
 
 }
@@ -25,7 +25,13 @@
 namespace KDL
 {
     ChainFkSolverVel_recursive::ChainFkSolverVel_recursive(const Chain& _chain):
-        chain(_chain)
+        ChainFkSolverVel_recursive(std::make_shared<const Chain>(_chain))
+    {
+    }
+
+    ChainFkSolverVel_recursive::ChainFkSolverVel_recursive(const ChainConstPtr& _chain):
+        chain_ptr(_chain),
+        chain(*chain_ptr)
     {
     }
 
@@ -35,6 +41,7 @@ namespace KDL
 
     int ChainFkSolverVel_recursive::JntToCart(const JntArrayVel& in,FrameVel& out,int seg_nr)
     {
+        KDL_SOLVER_TELEMETRY_SCOPE();
         std::size_t segmentNr;
         if(seg_nr<0)
             segmentNr=chain.getNrOfSegments();
@@ -66,6 +73,7 @@ namespace KDL
 
     int ChainFkSolverVel_recursive::JntToCart(const JntArrayVel& in,std::vector<FrameVel>& out,int seg_nr)
     {
+        KDL_SOLVER_TELEMETRY_SCOPE();
         std::size_t segmentNr;
         if(seg_nr<0)
             segmentNr=chain.getNrOfSegments();
@@ -75,13 +83,13 @@ namespace KDL
 
 
         if(!(in.q.rows()==chain.getNrOfJoints()&&in.qdot.rows()==chain.getNrOfJoints()))
-            return -1;
+            return (error = -1);
         else if(segmentNr>chain.getNrOfSegments())
-            return -1;
+            return (error = -1);
         else if(out.size()!=segmentNr)
-            return -1;
+            return (error = -1);
         else if(segmentNr == 0)
-            return -1;
+            return (error = -1);
         else{
             int j=0;
             // Initialization
@@ -104,7 +112,7 @@ namespace KDL
                                      chain.getSegment(i).twist(0.0,0.0));
                 }
             }
-            return 0;
+            return (error = E_NOERROR);
         }
     }
 }
@@ -38,13 +38,16 @@ namespace KDL
     {
     public:
         ChainFkSolverVel_recursive(const Chain& chain);
+        /// Shares the immutable \a chain with other solvers instead of copying it.
+        ChainFkSolverVel_recursive(const ChainConstPtr& chain);
         ~ChainFkSolverVel_recursive();
 
         virtual int JntToCart(const JntArrayVel& q_in,FrameVel& out,int segmentNr=-1);
         virtual int JntToCart(const JntArrayVel& q_in,std::vector<FrameVel>& out,int segmentNr=-1);
         virtual void updateInternalDataStructures() {};
     private:
-        const Chain chain;
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
     };
 }
 
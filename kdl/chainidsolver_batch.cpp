@@ -0,0 +1,185 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainidsolver_batch.hpp"
+
+#include <algorithm>
+
+namespace KDL
+{
+    ChainIdSolver_Batch::ThreadState::ThreadState(std::size_t ns, std::size_t nj) :
+        X(ns), f(ns), q(nj), q_dot(nj), passive(nj), error(E_NOERROR)
+    {
+    }
+
+    void ChainIdSolver_Batch::ThreadState::resize(std::size_t ns, std::size_t nj)
+    {
+        X.resize(ns);
+        f.resize(ns);
+        q.resize(nj);
+        q_dot.resize(nj);
+        passive.resize(nj);
+    }
+
+    ChainIdSolver_Batch::ChainIdSolver_Batch(const Chain& _chain, Vector grav, std::size_t _nr_of_threads,
+                                             std::size_t _block_size) :
+        ChainIdSolver_Batch(std::make_shared<const Chain>(_chain), grav, _nr_of_threads, _block_size)
+    {
+    }
+
+    ChainIdSolver_Batch::ChainIdSolver_Batch(const ChainConstPtr& _chain, Vector grav, std::size_t _nr_of_threads,
+                                             std::size_t _block_size) :
+        chain_ptr(_chain), chain(*chain_ptr), nj(0), ns(0),
+        ag(-Twist(grav,Vector::Zero())),
+        pool(_nr_of_threads),
+        threads(pool.size(), ThreadState(0, 0)),
+        block_size(_block_size > 0 ? _block_size : 1)
+    {
+        updateInternalDataStructures();
+    }
+
+    ChainIdSolver_Batch::~ChainIdSolver_Batch()
+    {
+    }
+
+    void ChainIdSolver_Batch::updateInternalDataStructures()
+    {
+        nj = chain.getNrOfJoints();
+        ns = chain.getNrOfSegments();
+        //The unit twist of a joint does not depend on q in the segment frame
+        S.resize(ns);
+        for(std::size_t i=0;i<ns;i++){
+            const Segment& segment=chain.getSegment(i);
+            S[i]=segment.pose(0.0).M.Inverse(segment.twist(0.0,1.0));
+        }
+        for(std::size_t t=0;t<threads.size();t++)
+            threads[t].resize(ns, nj);
+    }
+
+    int ChainIdSolver_Batch::checkSizes(const Eigen::MatrixXd& q, const Eigen::MatrixXd& torques) const
+    {
+        if(nj != chain.getNrOfJoints() || ns != chain.getNrOfSegments())
+            return E_NOT_UP_TO_DATE;
+        if((std::size_t)q.rows()!=nj || torques.rows()!=q.rows() || torques.cols()!=q.cols())
+            return E_SIZE_MISMATCH;
+        return E_NOERROR;
+    }
+
+    int ChainIdSolver_Batch::CartToJnt(const Eigen::MatrixXd& q, const Eigen::MatrixXd& q_dot, const Eigen::MatrixXd& q_dotdot,
+                                       Eigen::MatrixXd& torques)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        error = checkSizes(q, torques);
+        if(error != E_NOERROR)
+            return error;
+        if(q_dot.rows()!=q.rows() || q_dot.cols()!=q.cols() || q_dotdot.rows()!=q.rows() || q_dotdot.cols()!=q.cols())
+            return (error = E_SIZE_MISMATCH);
+
+        const std::size_t n = q.cols();
+        for(std::size_t t=0;t<threads.size();t++)
+            threads[t].error = E_NOERROR;
+        pool.parallel_for((n + block_size - 1) / block_size, [&](std::size_t block, std::size_t t) {
+            ThreadState& state = threads[t];
+            const std::size_t end = std::min(n, (block + 1) * block_size);
+            for(std::size_t k = block * block_size; k < end; ++k){
+                rne(q.col(k).data(), q_dot.col(k).data(), q_dotdot.col(k).data(), torques.col(k).data(), state);
+                if(torque_model){
+                    //passive torques of the joint model, as ChainIdSolver_RNE
+                    state.q.data = q.col(k);
+                    state.q_dot.data = q_dot.col(k);
+                    const int rc = torque_model->JntToTorque(state.q, state.q_dot, state.passive);
+                    if(rc < 0)
+                        state.error = rc;
+                    else
+                        torques.col(k) -= state.passive.data;
+                }
+            }
+        });
+        for(std::size_t t=0;t<threads.size();t++)
+            if(threads[t].error != E_NOERROR)
+                return (error = threads[t].error);
+        return (error = E_NOERROR);
+    }
+
+    int ChainIdSolver_Batch::JntToGravity(const Eigen::MatrixXd& q, Eigen::MatrixXd& gravity)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        error = checkSizes(q, gravity);
+        if(error != E_NOERROR)
+            return error;
+
+        const std::size_t n = q.cols();
+        pool.parallel_for((n + block_size - 1) / block_size, [&](std::size_t block, std::size_t t) {
+            const std::size_t end = std::min(n, (block + 1) * block_size);
+            for(std::size_t k = block * block_size; k < end; ++k)
+                rne(q.col(k).data(), NULL, NULL, gravity.col(k).data(), threads[t]);
+        });
+        return (error = E_NOERROR);
+    }
+
+    void ChainIdSolver_Batch::rne(const double* q, const double* q_dot, const double* q_dotdot, double* torques,
+                                  ThreadState& state) const
+    {
+        //Recursive Newton-Euler as ChainIdSolver_RNE, without the velocity
+        //terms if q_dot is NULL
+        std::vector<Frame>& X=state.X;
+        std::vector<Wrench>& f=state.f;
+        Twist v,a;
+        std::size_t j=0;
+
+        //Sweep from root to leaf
+        for(std::size_t i=0;i<ns;i++){
+            const Segment& segment=chain.getSegment(i);
+            const bool moving=segment.getJoint().getType()!=Joint::Fixed;
+            X[i]=segment.pose(moving ? q[j] : 0.0);
+            const RigidBodyInertia& Ii=segment.getInertia();
+            if(q_dot){
+                Twist vj;
+                double qdotdot_=0.0;
+                if(moving){
+                    vj=S[i]*q_dot[j];
+                    qdotdot_=q_dotdot[j];
+                }
+                if(i==0){
+                    v=vj;
+                    a=X[i].Inverse(ag)+S[i]*qdotdot_+v*vj;
+                }else{
+                    v=X[i].Inverse(v)+vj;
+                    a=X[i].Inverse(a)+S[i]*qdotdot_+v*vj;
+                }
+                f[i]=Ii*a+v*(Ii*v);
+            }else{
+                a=X[i].Inverse(i==0 ? ag : a);
+                f[i]=Ii*a;
+            }
+            if(moving)
+                j++;
+        }
+
+        //Sweep from leaf to root
+        for(int i=ns-1;i>=0;i--){
+            const Joint& joint=chain.getSegment(i).getJoint();
+            if(joint.getType()!=Joint::Fixed){
+                --j;
+                torques[j]=dot(S[i],f[i]);
+                if(q_dot)
+                    torques[j]+=joint.getInertia()*q_dotdot[j];
+            }
+            if(i!=0)
+                f[i-1]=f[i-1]+X[i]*f[i];
+        }
+    }
+}
@@ -0,0 +1,130 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_CHAINIDSOLVER_BATCH_HPP
+#define KDL_CHAINIDSOLVER_BATCH_HPP
+
+#include "chain.hpp"
+#include "jntarray.hpp"
+#include "jointtorquemodel.hpp"
+#include "solveri.hpp"
+#include "utilities/thread_pool.hpp"
+
+#include <Eigen/Core>
+#include <vector>
+
+namespace KDL
+{
+    /**
+     * \brief Inverse dynamics of many samples at once, e.g. to check the
+     * torques along a trajectory.
+     *
+     * The samples are the columns of the joint position, velocity and
+     * acceleration matrices.  Every sample is solved with the recursive
+     * Newton-Euler algorithm of ChainIdSolver_RNE, without external
+     * forces.  The unit twists of the joints, which are constant in the
+     * segment frames, are computed once instead of per sample.  The
+     * passive torques of a JointTorqueModel set with setJointTorqueModel()
+     * are subtracted from the torques, as by ChainIdSolver_RNE.
+     *
+     * The samples are split into blocks of consecutive samples that the
+     * threads of a ThreadPool take as they become idle.  Every thread has
+     * its own workspace: solving a batch does not allocate memory.
+     *
+     * @ingroup KinematicFamily
+     */
+    class ChainIdSolver_Batch : public SolverI
+    {
+    public:
+        /**
+         * @param chain the chain to calculate the inverse dynamics for, an internal copy will be made
+         * @param grav the gravity vector
+         * @param nr_of_threads number of threads, including the calling thread.
+         *        0 selects the number of hardware threads.
+         * @param block_size number of consecutive samples handed to a thread at once.
+         */
+        ChainIdSolver_Batch(const Chain& chain, Vector grav, std::size_t nr_of_threads=0, std::size_t block_size=64);
+        /// Shares the immutable \a chain with other solvers instead of copying it.
+        ChainIdSolver_Batch(const ChainConstPtr& chain, Vector grav, std::size_t nr_of_threads=0, std::size_t block_size=64);
+        ~ChainIdSolver_Batch();
+
+        /**
+         * Calculates the joint torques of every sample.
+         *
+         * @param q joint positions, nj x N
+         * @param q_dot joint velocities, nj x N
+         * @param q_dotdot joint accelerations, nj x N
+         * @param torques receives the joint torques, nj x N (not resized)
+         * @return E_SIZE_MISMATCH if the sizes of the arguments do not match,
+         * the first error of the joint torque model otherwise
+         */
+        int CartToJnt(const Eigen::MatrixXd& q, const Eigen::MatrixXd& q_dot, const Eigen::MatrixXd& q_dotdot,
+                      Eigen::MatrixXd& torques);
+
+        /**
+         * Calculates the gravity torques of every sample, i.e. CartToJnt
+         * with zero velocities and accelerations and without the joint
+         * torque model.  The velocities and the velocity products are not
+         * computed at all.
+         *
+         * @param q joint positions, nj x N
+         * @param gravity receives the joint torques, nj x N (not resized)
+         * @return E_SIZE_MISMATCH if the sizes of the arguments do not match
+         */
+        int JntToGravity(const Eigen::MatrixXd& q, Eigen::MatrixXd& gravity);
+
+        /**
+         * Sets the friction, damping and elasticity of the joints, NULL
+         * (the default) for none.  \a model is shared, not copied.
+         */
+        void setJointTorqueModel(const JointTorqueModelConstPtr& model) { torque_model = model; }
+        const JointTorqueModelConstPtr& getJointTorqueModel() const { return torque_model; }
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+    private:
+        // workspace of one thread
+        struct ThreadState
+        {
+            ThreadState(std::size_t ns, std::size_t nj);
+            void resize(std::size_t ns, std::size_t nj);
+            std::vector<Frame> X;
+            std::vector<Wrench> f;
+            // one sample and its passive torques, for the joint torque model
+            JntArray q;
+            JntArray q_dot;
+            JntArray passive;
+            int error;
+        };
+
+        int checkSizes(const Eigen::MatrixXd& q, const Eigen::MatrixXd& torques) const;
+        void rne(const double* q, const double* q_dot, const double* q_dotdot, double* torques, ThreadState& state) const;
+
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
+        std::size_t nj;
+        std::size_t ns;
+        std::vector<Twist> S;
+        Twist ag;
+        ThreadPool pool;
+        std::vector<ThreadState> threads;
+        std::size_t block_size;
+        JointTorqueModelConstPtr torque_model;
+    };
+}
+
+#endif
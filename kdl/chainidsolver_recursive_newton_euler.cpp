@@ -25,8 +25,13 @@
 namespace KDL{
 
     ChainIdSolver_RNE::ChainIdSolver_RNE(const Chain& chain_,Vector grav):
-        chain(chain_),nj(chain.getNrOfJoints()),ns(chain.getNrOfSegments()),
-        X(ns),S(ns),v(ns),a(ns),f(ns)
+        ChainIdSolver_RNE(std::make_shared<const Chain>(chain_),grav)
+    {
+    }
+
+    ChainIdSolver_RNE::ChainIdSolver_RNE(const ChainConstPtr& chain_,Vector grav):
+        chain_ptr(chain_),chain(*chain_ptr),nj(chain.getNrOfJoints()),ns(chain.getNrOfSegments()),
+        X(ns),S(ns),v(ns),a(ns),f(ns),passive(nj)
     {
         ag=-Twist(grav,Vector::Zero());
     }
@@ -39,16 +44,23 @@ namespace KDL{
         v.resize(ns);
         a.resize(ns);
         f.resize(ns);
+        passive.resize(nj);
     }
 
     int ChainIdSolver_RNE::CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &q_dotdot, const Wrenches& f_ext,JntArray &torques)
     {
+        KDL_SOLVER_TELEMETRY_SCOPE();
         if(nj != chain.getNrOfJoints() || ns != chain.getNrOfSegments())
             return (error = E_NOT_UP_TO_DATE);
 
         //Check sizes when in debug mode
         if(q.rows()!=nj || q_dot.rows()!=nj || q_dotdot.rows()!=nj || torques.rows()!=nj || f_ext.size()!=ns)
             return (error = E_SIZE_MISMATCH);
+        if(torque_model){
+            error = torque_model->JntToTorque(q, q_dot, passive);
+            if(error < 0)
+                return error;
+        }
         std::size_t j=0;
 
         //Sweep from root to leaf
@@ -90,6 +102,8 @@ namespace KDL{
             if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed) {
                 torques(j)=dot(S[i],f[i]);
                 torques(j)+=chain.getSegment(i).getJoint().getInertia()*q_dotdot(j);  // add torque from joint inertia
+                if(torque_model)
+                    torques(j)-=passive(j);  // passive torques of the joint model
                 --j;
             }
             if(i!=0)
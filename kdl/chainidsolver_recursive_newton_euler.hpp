@@ -23,6 +23,7 @@
 #define KDL_CHAIN_IKSOLVER_RECURSIVE_NEWTON_EULER_HPP
 
 #include "chainidsolver.hpp"
+#include "jointtorquemodel.hpp"
 
 namespace KDL{
     /**
@@ -36,6 +37,9 @@ namespace KDL{
      * the joints (q,qdot,qdotdot), external forces on the segments
      * (expressed in the segments reference frame) and the dynamical
      * parameters of the segments.
+     *
+     * The passive torques of a JointTorqueModel set with
+     * setJointTorqueModel() are subtracted from the resulting torques.
      */
     class ChainIdSolver_RNE : public ChainIdSolver{
     public:
@@ -45,6 +49,11 @@ namespace KDL{
          * \param grav The gravity vector to use during the calculation.
          */
         ChainIdSolver_RNE(const Chain& chain,Vector grav);
+        /**
+         * Constructor for the solver sharing \a chain with other solvers
+         * instead of making an internal copy.
+         */
+        ChainIdSolver_RNE(const ChainConstPtr& chain,Vector grav);
         ~ChainIdSolver_RNE(){};
         
         /**
@@ -59,11 +68,19 @@ namespace KDL{
          */
         int CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &q_dotdot, const Wrenches& f_ext,JntArray &torques);
 
+        /**
+         * Sets the friction, damping and elasticity of the joints, NULL
+         * (the default) for none.  \a model is shared, not copied.
+         */
+        void setJointTorqueModel(const JointTorqueModelConstPtr& model) { torque_model = model; }
+        const JointTorqueModelConstPtr& getJointTorqueModel() const { return torque_model; }
+
         /// @copydoc KDL::SolverI::updateInternalDataStructures
         virtual void updateInternalDataStructures();
 
     private:
-        const Chain chain;
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
         std::size_t nj;
         std::size_t ns;
         std::vector<Frame> X;
@@ -72,6 +89,8 @@ namespace KDL{
         std::vector<Twist> a;
         std::vector<Wrench> f;
         Twist ag;
+        JointTorqueModelConstPtr torque_model;
+        JntArray passive;
     };
 }
 
@@ -0,0 +1,190 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainidsolver_rne_derivatives.hpp"
+
+namespace KDL{
+
+    ChainIdSolver_RNE_Derivatives::ChainIdSolver_RNE_Derivatives(const Chain& chain_, Vector grav):
+        ChainIdSolver_RNE_Derivatives(std::make_shared<const Chain>(chain_), grav)
+    {
+    }
+
+    ChainIdSolver_RNE_Derivatives::ChainIdSolver_RNE_Derivatives(const ChainConstPtr& chain_, Vector grav):
+        chain_ptr(chain_), chain(*chain_ptr), nj(chain.getNrOfJoints()), ns(chain.getNrOfSegments()),
+        X(ns), S(ns), v(ns), vj(ns), a_p(ns), h(ns), f(ns), df(ns), joint_segment(nj),
+        passive(nj), dpassive_dq(nj,nj), dpassive_dqdot(nj,nj)
+    {
+        ag=-Twist(grav,Vector::Zero());
+    }
+
+    void ChainIdSolver_RNE_Derivatives::updateInternalDataStructures() {
+        nj = chain.getNrOfJoints();
+        ns = chain.getNrOfSegments();
+        X.resize(ns);
+        S.resize(ns);
+        v.resize(ns);
+        vj.resize(ns);
+        a_p.resize(ns);
+        h.resize(ns);
+        f.resize(ns);
+        df.resize(ns);
+        joint_segment.resize(nj);
+        passive.resize(nj);
+        dpassive_dq.resize(nj,nj);
+        dpassive_dqdot.resize(nj,nj);
+    }
+
+    int ChainIdSolver_RNE_Derivatives::CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &q_dotdot, const Wrenches& f_ext, JntArray &torques)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        error = rne(q, q_dot, q_dotdot, f_ext, torques);
+        if(error != E_NOERROR)
+            return error;
+        if(torque_model){
+            error = torque_model->JntToTorque(q, q_dot, passive);
+            if(error < 0)
+                return error;
+            torques.data -= passive.data;
+        }
+        return (error = E_NOERROR);
+    }
+
+    int ChainIdSolver_RNE_Derivatives::CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &q_dotdot, const Wrenches& f_ext,
+                                                 JntArray &torques, Eigen::MatrixXd& dtorques_dq, Eigen::MatrixXd& dtorques_dqdot)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        if((std::size_t)dtorques_dq.rows()!=nj || (std::size_t)dtorques_dq.cols()!=nj ||
+           (std::size_t)dtorques_dqdot.rows()!=nj || (std::size_t)dtorques_dqdot.cols()!=nj)
+            return (error = E_SIZE_MISMATCH);
+
+        error = rne(q, q_dot, q_dotdot, f_ext, torques);
+        if(error != E_NOERROR)
+            return error;
+
+        for(std::size_t k=0;k<nj;k++){
+            differentiate(k, true, dtorques_dq);
+            differentiate(k, false, dtorques_dqdot);
+        }
+        // passive torques of the joint model, as in ChainIdSolver_RNE
+        if(torque_model){
+            error = torque_model->JntToTorqueDerivatives(q, q_dot, passive, dpassive_dq, dpassive_dqdot);
+            if(error < 0)
+                return error;
+            torques.data -= passive.data;
+            dtorques_dq -= dpassive_dq;
+            dtorques_dqdot -= dpassive_dqdot;
+        }
+        return (error = E_NOERROR);
+    }
+
+    int ChainIdSolver_RNE_Derivatives::rne(const JntArray &q, const JntArray &q_dot, const JntArray &q_dotdot, const Wrenches& f_ext, JntArray &torques)
+    {
+        if(nj != chain.getNrOfJoints() || ns != chain.getNrOfSegments())
+            return E_NOT_UP_TO_DATE;
+
+        if(q.rows()!=nj || q_dot.rows()!=nj || q_dotdot.rows()!=nj || torques.rows()!=nj || f_ext.size()!=ns)
+            return E_SIZE_MISMATCH;
+
+        //Sweep from root to leaf, as ChainIdSolver_RNE, keeping the
+        //intermediate results needed by the derivatives
+        std::size_t j=0;
+        Twist a;
+        for(std::size_t i=0;i<ns;i++){
+            const Segment& segment=chain.getSegment(i);
+            double q_,qdot_,qdotdot_;
+            if(segment.getJoint().getType()!=Joint::Fixed) {
+                q_=q(j);
+                qdot_=q_dot(j);
+                qdotdot_=q_dotdot(j);
+                joint_segment[j]=i;
+                j++;
+            }else
+                q_=qdot_=qdotdot_=0.0;
+
+            X[i]=segment.pose(q_);
+            S[i]=X[i].M.Inverse(segment.twist(q_,1.0));
+            vj[i]=S[i]*qdot_;
+            if(i==0){
+                v[i]=vj[i];
+                a_p[i]=X[i].Inverse(ag);
+            }else{
+                v[i]=X[i].Inverse(v[i-1])+vj[i];
+                a_p[i]=X[i].Inverse(a);
+            }
+            a=a_p[i]+S[i]*qdotdot_+v[i]*vj[i];
+
+            const RigidBodyInertia& Ii=segment.getInertia();
+            h[i]=Ii*v[i];
+            f[i]=Ii*a+v[i]*h[i]-f_ext[i];
+        }
+        //Sweep from leaf to root
+        j=nj;
+        for(int i=ns-1;i>=0;i--){
+            const Joint& joint=chain.getSegment(i).getJoint();
+            if(joint.getType()!=Joint::Fixed) {
+                --j;
+                torques(j)=dot(S[i],f[i])+joint.getInertia()*q_dotdot(j);
+            }
+            if(i!=0)
+                f[i-1]=f[i-1]+X[i]*f[i];
+        }
+        return E_NOERROR;
+    }
+
+    void ChainIdSolver_RNE_Derivatives::differentiate(std::size_t k, bool position, Eigen::MatrixXd& dtorques)
+    {
+        const std::size_t s=joint_segment[k];
+
+        //Sweep from segment s to leaf: derivatives of the velocities,
+        //accelerations and body forces.  Segments before s do not depend on joint k.
+        Twist dv,da;
+        if(position){
+            //d(X^-1 y)/dq = -S x (X^-1 y) = (X^-1 y) x S
+            dv=(v[s]-vj[s])*S[s];
+            da=a_p[s]*S[s]+dv*vj[s];
+        }else{
+            dv=S[s];
+            da=v[s]*S[s];
+        }
+        for(std::size_t i=s;i<ns;i++){
+            if(i!=s){
+                dv=X[i].Inverse(dv);
+                da=X[i].Inverse(da)+dv*vj[i];
+            }
+            const RigidBodyInertia& Ii=chain.getSegment(i).getInertia();
+            df[i]=Ii*da+dv*h[i]+v[i]*(Ii*dv);
+        }
+
+        //Sweep from leaf to root: derivatives of the transmitted forces and the torques
+        for(std::size_t i=0;i<s;i++)
+            df[i]=Wrench::Zero();
+        std::size_t j=nj;
+        for(int i=ns-1;i>=0;i--){
+            if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed) {
+                --j;
+                dtorques(j,k)=dot(S[i],df[i]);
+            }
+            if(i!=0){
+                if(position && (std::size_t)i==s)
+                    //d(X f)/dq = X (S x* f)
+                    df[i-1]=df[i-1]+X[i]*(df[i]+S[i]*f[i]);
+                else
+                    df[i-1]=df[i-1]+X[i]*df[i];
+            }
+        }
+    }
+}//namespace
@@ -0,0 +1,120 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_CHAIN_IDSOLVER_RNE_DERIVATIVES_HPP
+#define KDL_CHAIN_IDSOLVER_RNE_DERIVATIVES_HPP
+
+#include "chainidsolver.hpp"
+#include "jointtorquemodel.hpp"
+
+#include <Eigen/Core>
+
+namespace KDL{
+    /**
+     * \brief Recursive newton euler inverse dynamics solver, with the
+     * partial derivatives of the torques with respect to the joint
+     * positions and velocities.
+     *
+     * The torques are those of ChainIdSolver_RNE, with the same
+     * conventions (external forces on the segments expressed in the
+     * segments reference frame, constant in these frames).  The derivatives
+     * are computed analytically by differentiating the recursions of the
+     * RNE along every joint: the motion subspace of a joint is constant in
+     * its segment frame, so a change of q_k only rotates the quantities
+     * crossing joint k (d(X^-1 v)/dq_k = -S_k x X^-1 v).  This costs O(n)
+     * per joint, O(n^2) for the dense matrices, without finite differences.
+     *
+     * The passive torques of a JointTorqueModel set with
+     * setJointTorqueModel() are subtracted from the resulting torques, and
+     * their derivatives, see JointTorqueModel::JntToTorqueDerivatives(),
+     * from the derivatives.
+     */
+    class ChainIdSolver_RNE_Derivatives : public ChainIdSolver{
+    public:
+        /**
+         * Constructor for the solver, it will allocate all the necessary memory
+         * \param chain The kinematic chain to calculate the inverse dynamics for, an internal copy will be made.
+         * \param grav The gravity vector to use during the calculation.
+         */
+        ChainIdSolver_RNE_Derivatives(const Chain& chain, Vector grav);
+        /**
+         * Constructor for the solver sharing \a chain with other solvers
+         * instead of making an internal copy.
+         */
+        ChainIdSolver_RNE_Derivatives(const ChainConstPtr& chain, Vector grav);
+        ~ChainIdSolver_RNE_Derivatives(){};
+
+        /**
+         * Calculates the joint torques only, as ChainIdSolver_RNE.
+         */
+        int CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &q_dotdot, const Wrenches& f_ext, JntArray &torques);
+
+        /**
+         * Calculates the joint torques and their partial derivatives.
+         * Input parameters;
+         * \param q The current joint positions
+         * \param q_dot The current joint velocities
+         * \param q_dotdot The current joint accelerations
+         * \param f_ext The external forces (no gravity) on the segments
+         * Output parameters:
+         * \param torques the resulting torques for the joints
+         * \param dtorques_dq nj x nj matrix, element (i,k) is d torques(i) / d q(k)
+         * \param dtorques_dqdot nj x nj matrix, element (i,k) is d torques(i) / d q_dot(k)
+         *
+         * The derivative with respect to q_dotdot is the joint space inertia
+         * matrix, see ChainDynParam::JntToMass.
+         *
+         * \return the error of the joint torque model if it has no derivatives
+         */
+        int CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &q_dotdot, const Wrenches& f_ext,
+                      JntArray &torques, Eigen::MatrixXd& dtorques_dq, Eigen::MatrixXd& dtorques_dqdot);
+
+        /**
+         * Sets the friction, damping and elasticity of the joints, NULL
+         * (the default) for none.  \a model is shared, not copied.
+         */
+        void setJointTorqueModel(const JointTorqueModelConstPtr& model) { torque_model = model; }
+        const JointTorqueModelConstPtr& getJointTorqueModel() const { return torque_model; }
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+    private:
+        int rne(const JntArray &q, const JntArray &q_dot, const JntArray &q_dotdot, const Wrenches& f_ext, JntArray &torques);
+        void differentiate(std::size_t k, bool position, Eigen::MatrixXd& dtorques);
+
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
+        std::size_t nj;
+        std::size_t ns;
+        std::vector<Frame> X;
+        std::vector<Twist> S;
+        std::vector<Twist> v;
+        std::vector<Twist> vj;
+        std::vector<Twist> a_p;   // acceleration of the parent, in segment coordinates
+        std::vector<Wrench> h;    // momentum I*v
+        std::vector<Wrench> f;    // force transmitted by the joint
+        std::vector<Wrench> df;   // derivative of f along one joint
+        std::vector<std::size_t> joint_segment;
+        Twist ag;
+        JointTorqueModelConstPtr torque_model;
+        JntArray passive;
+        Eigen::MatrixXd dpassive_dq;
+        Eigen::MatrixXd dpassive_dqdot;
+    };
+}
+
+#endif
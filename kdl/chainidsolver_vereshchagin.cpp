@@ -30,8 +30,14 @@ namespace KDL
 {
 using namespace Eigen;
 
-ChainIdSolver_Vereshchagin::ChainIdSolver_Vereshchagin(const Chain& chain_, Twist root_acc, std::size_t _nc) :
-    chain(chain_), nj(chain.getNrOfJoints()), ns(chain.getNrOfSegments()), nc(_nc),
+ChainIdSolver_Vereshchagin::ChainIdSolver_Vereshchagin(const Chain& chain_, Twist root_acc, std::size_t _nc):
+    ChainIdSolver_Vereshchagin(std::make_shared<const Chain>(chain_), root_acc, _nc)
+{
+}
+
+ChainIdSolver_Vereshchagin::ChainIdSolver_Vereshchagin(const ChainConstPtr& chain_, Twist root_acc, std::size_t _nc):
+    chain_ptr(chain_),
+    chain(*chain_ptr), nj(chain.getNrOfJoints()), ns(chain.getNrOfSegments()), nc(_nc),
     results(ns + 1, segment_info(nc))
 {
     acc_root = root_acc;
@@ -52,6 +58,7 @@ void ChainIdSolver_Vereshchagin::updateInternalDataStructures() {
 
 int ChainIdSolver_Vereshchagin::CartToJnt(const JntArray &q, const JntArray &q_dot, JntArray &q_dotdot, const Jacobian& alfa, const JntArray& beta, const Wrenches& f_ext, JntArray &torques)
 {
+    KDL_SOLVER_TELEMETRY_SCOPE();
     nj = chain.getNrOfJoints();
     if(ns != chain.getNrOfSegments())
         return (error = E_NOT_UP_TO_DATE);
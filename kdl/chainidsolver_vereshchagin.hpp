@@ -53,6 +53,8 @@ public:
      *
      */
     ChainIdSolver_Vereshchagin(const Chain& chain, Twist root_acc, std::size_t nc);
+    /// Shares the immutable \a chain with other solvers instead of copying it.
+    ChainIdSolver_Vereshchagin(const ChainConstPtr& chain, Twist root_acc, std::size_t nc);
 
     ~ChainIdSolver_Vereshchagin()
     {
@@ -122,7 +124,8 @@ private:
     void final_upwards_sweep(JntArray &q_dotdot, JntArray &torques);
 
 private:
-    const Chain chain;
+    const ChainConstPtr chain_ptr;
+    const Chain& chain;
     std::size_t nj;
     std::size_t ns;
     std::size_t nc;
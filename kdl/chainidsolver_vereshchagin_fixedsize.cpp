@@ -0,0 +1,272 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainidsolver_vereshchagin_fixedsize.hpp"
+
+#include <cmath>
+
+namespace KDL
+{
+    namespace
+    {
+        typedef Eigen::Map<const Eigen::Matrix<double,3,3,Eigen::RowMajor> > RotationMap;
+
+        //Columns of E as wrenches ordered (force; torque), transformed as Frame*Wrench
+        template <typename Matrix>
+        void transformWrenches(const Frame& T, const Matrix& E, Matrix& TE)
+        {
+            RotationMap R(T.M.data);
+            Eigen::Matrix3d p_cross;
+            p_cross << 0,-T.p(2),T.p(1), T.p(2),0,-T.p(0), -T.p(1),T.p(0),0;
+            TE.template topRows<3>().noalias()=R*E.template topRows<3>();
+            TE.template bottomRows<3>().noalias()=R*E.template bottomRows<3>();
+            TE.template bottomRows<3>().noalias()+=p_cross*TE.template topRows<3>();
+        }
+
+        Eigen::Matrix<double,6,1> toVector(const Twist& t)
+        {
+            Eigen::Matrix<double,6,1> v;
+            v << t.vel.x(), t.vel.y(), t.vel.z(), t.rot.x(), t.rot.y(), t.rot.z();
+            return v;
+        }
+    }
+
+    template <unsigned int NC>
+    ChainIdSolver_Vereshchagin_FixedSize<NC>::ChainIdSolver_Vereshchagin_FixedSize(const Chain& chain_, Twist root_acc):
+        ChainIdSolver_Vereshchagin_FixedSize(std::make_shared<const Chain>(chain_), root_acc)
+    {
+    }
+
+    template <unsigned int NC>
+    ChainIdSolver_Vereshchagin_FixedSize<NC>::ChainIdSolver_Vereshchagin_FixedSize(const ChainConstPtr& chain_, Twist root_acc):
+        chain_ptr(chain_), chain(*chain_ptr), nj(chain.getNrOfJoints()), ns(chain.getNrOfSegments()),
+        acc_root(root_acc),
+        F(ns), Z(ns), C(ns), U(ns), P(ns), D(ns), u(ns), EZ(ns)
+    {
+    }
+
+    template <unsigned int NC>
+    ChainIdSolver_Vereshchagin_FixedSize<NC>::~ChainIdSolver_Vereshchagin_FixedSize()
+    {
+    }
+
+    template <unsigned int NC>
+    void ChainIdSolver_Vereshchagin_FixedSize<NC>::updateInternalDataStructures()
+    {
+        nj = chain.getNrOfJoints();
+        ns = chain.getNrOfSegments();
+        F.resize(ns);
+        Z.resize(ns);
+        C.resize(ns);
+        U.resize(ns);
+        P.resize(ns);
+        D.resize(ns);
+        u.resize(ns);
+        EZ.resize(ns);
+    }
+
+    template <unsigned int NC>
+    int ChainIdSolver_Vereshchagin_FixedSize<NC>::CartToJnt(const JntArray &q, const JntArray &q_dot, JntArray &q_dotdot, const Jacobian& alfa,
+                                                             const JntArray& beta, const Wrenches& f_ext, JntArray &torques)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        if (alfa.columns() != NC || beta.rows() != NC)
+            return (error = E_SIZE_MISMATCH);
+        alfa_fixed = alfa.data;
+        return (error = solve(q, q_dot, q_dotdot, alfa_fixed, beta.data, f_ext, torques));
+    }
+
+    template <unsigned int NC>
+    int ChainIdSolver_Vereshchagin_FixedSize<NC>::CartToJnt(const JntArray &q, const JntArray &q_dot, JntArray &q_dotdot, const ConstraintForces& alfa,
+                                                             const ConstraintVector& beta, const Wrenches& f_ext, JntArray &torques)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        return (error = solve(q, q_dot, q_dotdot, alfa, beta, f_ext, torques));
+    }
+
+    template <unsigned int NC>
+    int ChainIdSolver_Vereshchagin_FixedSize<NC>::solve(const JntArray &q, const JntArray &q_dot, JntArray &q_dotdot, const ConstraintForces& alfa,
+                                                         const ConstraintVector& beta, const Wrenches& f_ext, JntArray &torques)
+    {
+        if (nj != chain.getNrOfJoints() || ns != chain.getNrOfSegments())
+            return E_NOT_UP_TO_DATE;
+        if (q.rows() != nj || q_dot.rows() != nj || q_dotdot.rows() != nj || torques.rows() != nj || f_ext.size() != ns)
+            return E_SIZE_MISMATCH;
+
+        initialUpwardsSweep(q, q_dot, f_ext);
+        const int rc = downwardsSweep(alfa, torques);
+        if (rc != E_NOERROR)
+            return rc;
+        constraintCalculation(beta);
+        finalUpwardsSweep(q_dotdot, torques);
+        return E_NOERROR;
+    }
+
+    template <unsigned int NC>
+    void ChainIdSolver_Vereshchagin_FixedSize<NC>::initialUpwardsSweep(const JntArray &q, const JntArray &q_dot, const Wrenches& f_ext)
+    {
+        std::size_t j = 0;
+        Twist v;
+        F_total = Frame::Identity();
+        for (std::size_t i = 0; i < ns; i++)
+        {
+            const Segment& segment = chain.getSegment(i);
+            double q_ = 0.0, qdot_ = 0.0;
+            if (segment.getJoint().getType() != Joint::Fixed)
+            {
+                q_ = q(j);
+                qdot_ = q_dot(j);
+                j++;
+            }
+            F[i] = segment.pose(q_);
+            F_total = F_total * F[i];
+
+            //joint velocity and unit twist in the segment frame, then Z in the joint root frame
+            const Twist vj = F[i].M.Inverse(segment.twist(q_, qdot_));
+            Z[i] = F[i] * F[i].M.Inverse(segment.twist(q_, 1.0));
+
+            v = (i == 0) ? vj : F[i].Inverse(v) + vj;
+            C[i] = F[i] * (v * vj);
+            U[i] = v * (segment.getInertia() * v) - F_total.M.Inverse() * f_ext[i];
+        }
+    }
+
+    template <unsigned int NC>
+    int ChainIdSolver_Vereshchagin_FixedSize<NC>::downwardsSweep(const ConstraintForces& alfa, const JntArray &torques)
+    {
+        //Quantities of the current segment before the transformation to the
+        //joint root (tilde in ChainIdSolver_Vereshchagin), and of its child after it
+        ArticulatedBodyInertia P_tilde;
+        Wrench R_tilde, R, PZ, PC;
+        ConstraintForces E_tilde, E;
+        ConstraintMatrix M;
+        ConstraintVector G;
+
+        //The constraints are given in the base frame, E is in the frame of the end effector
+        RotationMap R_end(F_total.M.data);
+        E.template topRows<3>().noalias() = R_end.transpose() * alfa.template topRows<3>();
+        E.template bottomRows<3>().noalias() = R_end.transpose() * alfa.template bottomRows<3>();
+        E_tilde.setZero();
+        M.setZero();
+        G.setZero();
+
+        std::size_t j = nj;
+        for (int i = ns; i >= 0; i--)
+        {
+            //Articulated body of segment i (the base for i == 0), from the child i
+            if (i == (int)ns)
+            {
+                P_tilde = ArticulatedBodyInertia();
+                R_tilde = Wrench::Zero();
+                E_tilde = E;
+            }
+            else
+            {
+                P_tilde = P[i];
+                R_tilde = R + PC;
+                E_tilde = E;
+                if (chain.getSegment(i).getJoint().getType() != Joint::Fixed)
+                {
+                    //equations a) to e) of Vereshchagin89
+                    const double Dinv = 1.0 / D[i];
+                    Eigen::Map<const Eigen::Vector3d> PZf(PZ.force.data), PZt(PZ.torque.data);
+                    P_tilde.M.noalias() -= Dinv * PZf * PZf.transpose();
+                    P_tilde.H.noalias() -= Dinv * PZt * PZf.transpose();
+                    P_tilde.I.noalias() -= Dinv * PZt * PZt.transpose();
+                    R_tilde += PZ * (u[i] * Dinv);
+                    Eigen::Matrix<double,6,1> vPZ;
+                    vPZ << Eigen::Vector3d::Map(PZ.force.data), Eigen::Vector3d::Map(PZ.torque.data);
+                    E_tilde.noalias() -= Dinv * vPZ * EZ[i].transpose();
+                    M.noalias() -= Dinv * EZ[i] * EZ[i].transpose();
+                    G.noalias() += E.transpose() * toVector(C[i] + Z[i] * (u[i] * Dinv));
+                }
+                else
+                    G.noalias() += E.transpose() * toVector(C[i]);
+            }
+            if (i == 0)
+                break;
+
+            //Segment i-1: add its own inertia and forces and transform to its joint root
+            const std::size_t s = i - 1;
+            const Segment& segment = chain.getSegment(s);
+            P_tilde = P_tilde + ArticulatedBodyInertia(segment.getInertia());
+            R_tilde = R_tilde + U[s];
+            P[s] = F[s] * P_tilde;
+            R = F[s] * R_tilde;
+            transformWrenches(F[s], E_tilde, E);
+            PC = P[s] * C[s];
+            if (segment.getJoint().getType() != Joint::Fixed)
+            {
+                --j;
+                PZ = P[s] * Z[s];
+                D[s] = dot(Z[s], PZ);
+                if (!(D[s] > 0))
+                    return E_UNDEFINED;
+                u[s] = torques(j) - dot(Z[s], R + PC);
+                EZ[s].noalias() = E.transpose() * toVector(Z[s]);
+            }
+        }
+        E_base = E_tilde;
+        M_base = M;
+        G_base = G;
+        return E_NOERROR;
+    }
+
+    template <unsigned int NC>
+    void ChainIdSolver_Vereshchagin_FixedSize<NC>::constraintCalculation(const ConstraintVector& beta)
+    {
+        //equation f) nu = M_0^-1 (beta - E_0^T acc_root - G_0), with the
+        //pseudo-inverse of the symmetric M_0
+        eig.compute(M_base);
+        ConstraintVector inv;
+        for (unsigned int k = 0; k < NC; k++)
+            inv(k) = std::abs(eig.eigenvalues()(k)) < 1e-14 ? 0.0 : 1.0 / eig.eigenvalues()(k);
+        ConstraintVector nu_sum = beta - G_base;
+        nu_sum.noalias() -= E_base.transpose() * toVector(acc_root);
+        ConstraintVector tmp;
+        tmp.noalias() = eig.eigenvectors().transpose() * nu_sum;
+        tmp = inv.cwiseProduct(tmp);
+        nu.noalias() = eig.eigenvectors() * tmp;
+    }
+
+    template <unsigned int NC>
+    void ChainIdSolver_Vereshchagin_FixedSize<NC>::finalUpwardsSweep(JntArray &q_dotdot, JntArray &torques)
+    {
+        //equation g) q_dotdot = D^-1 (u - Z^T (P a_parent + E nu))
+        std::size_t j = 0;
+        Twist a_p = acc_root;
+        for (std::size_t i = 0; i < ns; i++)
+        {
+            if (chain.getSegment(i).getJoint().getType() != Joint::Fixed)
+            {
+                const double constraint_torque = -EZ[i].dot(nu);
+                torques(j) = constraint_torque;
+                q_dotdot(j) = (u[i] - dot(Z[i], P[i] * a_p) + constraint_torque) / D[i];
+                a_p = F[i].Inverse(a_p + Z[i] * q_dotdot(j) + C[i]);
+                j++;
+            }
+            else
+                a_p = F[i].Inverse(a_p + C[i]);
+        }
+    }
+
+    template class ChainIdSolver_Vereshchagin_FixedSize<1>;
+    template class ChainIdSolver_Vereshchagin_FixedSize<2>;
+    template class ChainIdSolver_Vereshchagin_FixedSize<3>;
+    template class ChainIdSolver_Vereshchagin_FixedSize<4>;
+    template class ChainIdSolver_Vereshchagin_FixedSize<5>;
+    template class ChainIdSolver_Vereshchagin_FixedSize<6>;
+}
@@ -0,0 +1,137 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_CHAINIDSOLVER_VERESHCHAGIN_FIXEDSIZE_HPP
+#define KDL_CHAINIDSOLVER_VERESHCHAGIN_FIXEDSIZE_HPP
+
+#include "chainidsolver.hpp"
+#include "jacobian.hpp"
+#include "articulatedbodyinertia.hpp"
+
+#include <Eigen/Core>
+#include <Eigen/Eigenvalues>
+#include <vector>
+
+namespace KDL
+{
+    /**
+     * \brief ChainIdSolver_Vereshchagin with the number of constraints NC
+     * (1 to 6) known at compile time.
+     *
+     * The inputs, outputs and conventions are those of
+     * ChainIdSolver_Vereshchagin: \a alfa holds the unit constraint forces
+     * at the end effector as columns ordered (force; torque), expressed in
+     * the base frame, f_ext is expressed in the base orientation, and the
+     * torques are the input joint torques on entry and the constraint
+     * torques on return.
+     *
+     * All the constraint quantities are fixed-size Eigen types and the
+     * results of a segment that the last sweep needs are kept in one
+     * contiguous array per quantity; the quantities only needed by the
+     * parent of a segment are not stored at all.  The constraint equation
+     * is solved with a fixed-size symmetric eigen decomposition.  Once
+     * constructed, the solver does not allocate memory.
+     *
+     * Unlike ChainIdSolver_Vereshchagin, fixed segments are supported.
+     *
+     * Instantiated in the library for NC = 1 to 6.
+     *
+     * @ingroup KinematicFamily
+     */
+    template <unsigned int NC>
+    class ChainIdSolver_Vereshchagin_FixedSize : public SolverI
+    {
+        static_assert(NC >= 1 && NC <= 6, "the number of constraints must be between 1 and 6");
+
+    public:
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        typedef Eigen::Matrix<double, 6, NC> ConstraintForces;
+        typedef Eigen::Matrix<double, NC, 1> ConstraintVector;
+        typedef Eigen::Matrix<double, NC, NC> ConstraintMatrix;
+
+        /**
+         * Constructor for the solver, it will allocate all the necessary memory
+         * \param chain The kinematic chain to calculate the inverse dynamics for, an internal copy will be made.
+         * \param root_acc The acceleration vector of the root to use during the calculation.(most likely contains gravity)
+         */
+        ChainIdSolver_Vereshchagin_FixedSize(const Chain& chain, Twist root_acc);
+        /// Shares the immutable \a chain with other solvers instead of copying it.
+        ChainIdSolver_Vereshchagin_FixedSize(const ChainConstPtr& chain, Twist root_acc);
+        ~ChainIdSolver_Vereshchagin_FixedSize();
+
+        /**
+         * Calculates the joint accelerations and the constraint torques,
+         * see ChainIdSolver_Vereshchagin::CartToJnt.
+         *
+         * \param alfa 6 x NC unit constraint forces
+         * \param beta NC acceleration energies
+         * \return E_SIZE_MISMATCH if alfa or beta do not have NC columns,
+         * E_UNDEFINED if a joint moves no mass
+         */
+        int CartToJnt(const JntArray &q, const JntArray &q_dot, JntArray &q_dotdot, const Jacobian& alfa, const JntArray& beta, const Wrenches& f_ext, JntArray &torques);
+
+        /**
+         * Same as above, with the constraints as fixed-size matrices.
+         */
+        int CartToJnt(const JntArray &q, const JntArray &q_dot, JntArray &q_dotdot, const ConstraintForces& alfa, const ConstraintVector& beta, const Wrenches& f_ext, JntArray &torques);
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+    private:
+        int solve(const JntArray &q, const JntArray &q_dot, JntArray &q_dotdot, const ConstraintForces& alfa, const ConstraintVector& beta, const Wrenches& f_ext, JntArray &torques);
+        void initialUpwardsSweep(const JntArray &q, const JntArray &q_dot, const Wrenches& f_ext);
+        int downwardsSweep(const ConstraintForces& alfa, const JntArray &torques);
+        void constraintCalculation(const ConstraintVector& beta);
+        void finalUpwardsSweep(JntArray &q_dotdot, JntArray &torques);
+
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
+        std::size_t nj;
+        std::size_t ns;
+        Twist acc_root;
+        Frame F_total;
+
+        // Per segment, Z, C and P are expressed in the tip frame of the
+        // parent (the joint root), the others in the segment frame
+        std::vector<Frame> F;       // pose with respect to the parent
+        std::vector<Twist> Z;       // unit twist of the joint
+        std::vector<Twist> C;       // velocity product acceleration
+        std::vector<Wrench> U;      // bias and external forces
+        std::vector<ArticulatedBodyInertia> P;
+        std::vector<double> D;
+        std::vector<double> u;
+        std::vector<ConstraintVector, Eigen::aligned_allocator<ConstraintVector> > EZ;
+
+        // constraint quantities of the base
+        ConstraintForces alfa_fixed;
+        ConstraintForces E_base;
+        ConstraintMatrix M_base;
+        ConstraintVector G_base;
+        ConstraintVector nu;
+        Eigen::SelfAdjointEigenSolver<ConstraintMatrix> eig;
+    };
+
+    extern template class ChainIdSolver_Vereshchagin_FixedSize<1>;
+    extern template class ChainIdSolver_Vereshchagin_FixedSize<2>;
+    extern template class ChainIdSolver_Vereshchagin_FixedSize<3>;
+    extern template class ChainIdSolver_Vereshchagin_FixedSize<4>;
+    extern template class ChainIdSolver_Vereshchagin_FixedSize<5>;
+    extern template class ChainIdSolver_Vereshchagin_FixedSize<6>;
+}
+
+#endif
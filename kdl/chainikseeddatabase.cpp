@@ -0,0 +1,378 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainikseeddatabase.hpp"
+#include "chainfksolverpos_recursive.hpp"
+#include "utilities/thread_pool.hpp"
+#include "utilities/utility.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <random>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define KDL_SEED_DATABASE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace KDL
+{
+    const std::size_t ChainIkSeedDatabase::KEY_SIZE;
+
+    namespace
+    {
+        const char MAGIC[8] = {'K', 'D', 'L', 'I', 'K', 'S', 'D', 'B'};
+        const std::uint32_t VERSION = 1;
+
+        // file layout: header, keys, joint positions, split coordinates
+        struct Header
+        {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t nr_of_joints;
+            std::uint64_t nr_of_samples;
+            double rotation_scale;
+        };
+
+        // the key and position blocks follow the header, mapped at a page boundary
+        static_assert(sizeof(Header) % alignof(double) == 0, "misaligned sample blocks");
+
+        // bounds the size computations, a sample of a chain with more joints
+        // is not a sensible seed
+        const std::uint32_t MAX_NR_OF_JOINTS = 1024;
+
+        // checks that a file of \a size bytes holds exactly the samples
+        // announced by the header, without overflow
+        bool validSize(const Header& header, std::uint64_t size)
+        {
+            if (header.nr_of_joints == 0 || header.nr_of_joints > MAX_NR_OF_JOINTS || size < sizeof(Header))
+                return false;
+            const std::uint64_t sample_size = (ChainIkSeedDatabase::KEY_SIZE + header.nr_of_joints) * sizeof(double) + 1;
+            if (header.nr_of_samples > (size - sizeof(Header)) / sample_size)
+                return false;
+            return sizeof(Header) + header.nr_of_samples * sample_size == size;
+        }
+
+        bool validHeader(const Header& header)
+        {
+            return std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == VERSION;
+        }
+
+        // the search indexes the keys with the split coordinates
+        bool validSplit(const std::uint8_t* split, std::uint64_t n)
+        {
+            return std::all_of(split, split + n, [](std::uint8_t c) { return c < ChainIkSeedDatabase::KEY_SIZE; });
+        }
+
+        // sorts the samples idx[begin, end) into a k-d tree, splitting every node
+        // along the coordinate with the largest spread.
+        void sortTree(const std::vector<double>& keys, std::vector<std::size_t>& idx,
+                      std::vector<std::uint8_t>& split, std::size_t begin, std::size_t end)
+        {
+            const std::size_t K = ChainIkSeedDatabase::KEY_SIZE;
+            if (end - begin <= 1) {
+                if (end > begin)
+                    split[begin] = 0;
+                return;
+            }
+            double lo[K], hi[K];
+            for (std::size_t c = 0; c < K; ++c)
+                lo[c] = hi[c] = keys[idx[begin] * K + c];
+            for (std::size_t i = begin + 1; i < end; ++i)
+                for (std::size_t c = 0; c < K; ++c) {
+                    lo[c] = std::min(lo[c], keys[idx[i] * K + c]);
+                    hi[c] = std::max(hi[c], keys[idx[i] * K + c]);
+                }
+            std::uint8_t c = 0;
+            for (std::uint8_t k = 1; k < K; ++k)
+                if (hi[k] - lo[k] > hi[c] - lo[c])
+                    c = k;
+            const std::size_t mid = (begin + end) / 2;
+            std::nth_element(idx.begin() + begin, idx.begin() + mid, idx.begin() + end,
+                             [&](std::size_t a, std::size_t b) { return keys[a * K + c] < keys[b * K + c]; });
+            split[mid] = c;
+            sortTree(keys, idx, split, begin, mid);
+            sortTree(keys, idx, split, mid + 1, end);
+        }
+    }
+
+    ChainIkSeedDatabase::ChainIkSeedDatabase() :
+        nr_of_samples(0), nr_of_joints(0), rotation_scale(0),
+        keys(nullptr), positions(nullptr), split(nullptr),
+        mapping(nullptr), mapping_size(0)
+    {
+    }
+
+    ChainIkSeedDatabase::~ChainIkSeedDatabase()
+    {
+        clear();
+    }
+
+    void ChainIkSeedDatabase::clear()
+    {
+#ifdef KDL_SEED_DATABASE_MMAP
+        if (mapping)
+            munmap(mapping, mapping_size);
+#endif
+        mapping = nullptr;
+        mapping_size = 0;
+        key_storage.clear();
+        position_storage.clear();
+        split_storage.clear();
+        assign(nullptr, nullptr, nullptr);
+        nr_of_samples = 0;
+        nr_of_joints = 0;
+    }
+
+    void ChainIkSeedDatabase::assign(const double* _keys, const double* _positions, const std::uint8_t* _split)
+    {
+        keys = _keys;
+        positions = _positions;
+        split = _split;
+    }
+
+    void ChainIkSeedDatabase::toKey(const Frame& pose, double* key) const
+    {
+        const Vector x = pose.M.UnitX();
+        const Vector z = pose.M.UnitZ();
+        for (int i = 0; i < 3; ++i) {
+            key[i] = pose.p(i);
+            key[3 + i] = rotation_scale * x(i);
+            key[6 + i] = rotation_scale * z(i);
+        }
+    }
+
+    bool ChainIkSeedDatabase::build(const Chain& chain, std::size_t n, double _rotation_scale,
+                                    unsigned int random_seed, std::size_t nr_of_threads)
+    {
+        JntArray q_min(chain.getNrOfJoints()), q_max(chain.getNrOfJoints());
+        for (std::size_t i = 0, j = 0; i < chain.getNrOfSegments(); ++i) {
+            const Joint& joint = chain.getSegment(i).getJoint();
+            if (joint.getType() == Joint::Fixed)
+                continue;
+            if (joint.getLowerPositionLimit() < joint.getUpperPositionLimit()) {
+                q_min(j) = joint.getLowerPositionLimit();
+                q_max(j) = joint.getUpperPositionLimit();
+            } else {
+                q_min(j) = -PI;
+                q_max(j) = PI;
+            }
+            ++j;
+        }
+        return build(chain, n, q_min, q_max, _rotation_scale, random_seed, nr_of_threads);
+    }
+
+    bool ChainIkSeedDatabase::build(const Chain& chain, std::size_t n,
+                                    const JntArray& q_min, const JntArray& q_max,
+                                    double _rotation_scale, unsigned int random_seed,
+                                    std::size_t nr_of_threads)
+    {
+        const unsigned int nj = chain.getNrOfJoints();
+        if (nj == 0 || nj > MAX_NR_OF_JOINTS || q_min.rows() != nj || q_max.rows() != nj)
+            return false;
+
+        clear();
+        nr_of_joints = nj;
+        rotation_scale = _rotation_scale;
+
+        // samples are drawn sequentially, the generator is not thread-safe.
+        std::vector<double> sampled_positions(n * nj);
+        std::mt19937 rng(random_seed);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        for (std::size_t k = 0; k < n; ++k)
+            for (unsigned int j = 0; j < nj; ++j)
+                sampled_positions[k * nj + j] = q_min(j) + uniform(rng) * (q_max(j) - q_min(j));
+
+        // forward kinematics of the samples, in batches of consecutive samples per task
+        std::vector<double> sampled_keys(n * KEY_SIZE);
+        const ChainFkSolverPos_recursive fksolver(chain);
+        ThreadPool pool(nr_of_threads);
+        const std::size_t batch = 256;
+        pool.parallel_for((n + batch - 1) / batch, [&](std::size_t b, std::size_t) {
+            JntArray q(nj);
+            Frame pose;
+            for (std::size_t k = b * batch; k < std::min(n, (b + 1) * batch); ++k) {
+                for (unsigned int j = 0; j < nj; ++j)
+                    q(j) = sampled_positions[k * nj + j];
+                fksolver.JntToCart(q, pose);
+                toKey(pose, &sampled_keys[k * KEY_SIZE]);
+            }
+        });
+
+        std::vector<std::size_t> idx(n);
+        for (std::size_t k = 0; k < n; ++k)
+            idx[k] = k;
+        split_storage.resize(n);
+        sortTree(sampled_keys, idx, split_storage, 0, n);
+
+        key_storage.resize(n * KEY_SIZE);
+        position_storage.resize(n * nj);
+        for (std::size_t k = 0; k < n; ++k) {
+            std::copy_n(&sampled_keys[idx[k] * KEY_SIZE], KEY_SIZE, &key_storage[k * KEY_SIZE]);
+            std::copy_n(&sampled_positions[idx[k] * nj], nj, &position_storage[k * nj]);
+        }
+        nr_of_samples = n;
+        assign(key_storage.data(), position_storage.data(), split_storage.data());
+        return true;
+    }
+
+    bool ChainIkSeedDatabase::save(const std::string& filename) const
+    {
+        std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+        if (!file)
+            return false;
+        Header header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.nr_of_joints = nr_of_joints;
+        header.nr_of_samples = nr_of_samples;
+        header.rotation_scale = rotation_scale;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(keys), nr_of_samples * KEY_SIZE * sizeof(double));
+        file.write(reinterpret_cast<const char*>(positions), nr_of_samples * nr_of_joints * sizeof(double));
+        file.write(reinterpret_cast<const char*>(split), nr_of_samples);
+        return static_cast<bool>(file);
+    }
+
+    bool ChainIkSeedDatabase::load(const std::string& filename)
+    {
+        clear();
+#ifdef KDL_SEED_DATABASE_MMAP
+        const int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        void* data = MAP_FAILED;
+        if (fstat(fd, &st) == 0 && (std::size_t)st.st_size >= sizeof(Header))
+            data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED)
+            return false;
+        const Header& header = *static_cast<const Header*>(data);
+        if (!validHeader(header) || !validSize(header, st.st_size)) {
+            munmap(data, st.st_size);
+            return false;
+        }
+        const double* body = reinterpret_cast<const double*>(static_cast<const char*>(data) + sizeof(Header));
+        const std::uint8_t* split_data =
+            reinterpret_cast<const std::uint8_t*>(body + header.nr_of_samples * (KEY_SIZE + header.nr_of_joints));
+        if (!validSplit(split_data, header.nr_of_samples)) {
+            munmap(data, st.st_size);
+            return false;
+        }
+        mapping = data;
+        mapping_size = st.st_size;
+        assign(body, body + header.nr_of_samples * KEY_SIZE, split_data);
+#else
+        std::ifstream file(filename, std::ios::binary | std::ios::ate);
+        if (!file)
+            return false;
+        const std::size_t size = file.tellg();
+        Header header;
+        file.seekg(0);
+        if (size < sizeof(Header) || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            !validHeader(header) || !validSize(header, size))
+            return false;
+        key_storage.resize(header.nr_of_samples * KEY_SIZE);
+        position_storage.resize(header.nr_of_samples * header.nr_of_joints);
+        split_storage.resize(header.nr_of_samples);
+        file.read(reinterpret_cast<char*>(key_storage.data()), key_storage.size() * sizeof(double));
+        file.read(reinterpret_cast<char*>(position_storage.data()), position_storage.size() * sizeof(double));
+        file.read(reinterpret_cast<char*>(split_storage.data()), split_storage.size());
+        if (!file || !validSplit(split_storage.data(), split_storage.size())) {
+            clear();
+            return false;
+        }
+        assign(key_storage.data(), position_storage.data(), split_storage.data());
+#endif
+        nr_of_samples = header.nr_of_samples;
+        nr_of_joints = header.nr_of_joints;
+        rotation_scale = header.rotation_scale;
+        return true;
+    }
+
+    void ChainIkSeedDatabase::search(std::size_t begin, std::size_t end, const double* key, double scale,
+                                     std::vector<std::size_t>& indices, std::vector<double>& distances,
+                                     std::size_t& found) const
+    {
+        if (begin >= end)
+            return;
+        const std::size_t mid = (begin + end) / 2;
+        const double* node = keys + mid * KEY_SIZE;
+        double d2 = 0;
+        for (std::size_t c = 0; c < KEY_SIZE; ++c)
+            d2 += (key[c] - node[c]) * (key[c] - node[c]);
+
+        // insertion into the sorted list of the nearest samples so far
+        const std::size_t k = indices.size();
+        if (found < k || d2 < distances[k - 1]) {
+            std::size_t i = found < k ? found++ : k - 1;
+            for (; i > 0 && distances[i - 1] > d2; --i) {
+                distances[i] = distances[i - 1];
+                indices[i] = indices[i - 1];
+            }
+            distances[i] = d2;
+            indices[i] = mid;
+        }
+
+        const double delta = key[split[mid]] - node[split[mid]];
+        const bool left_first = delta < 0;
+        search(left_first ? begin : mid + 1, left_first ? mid : end, key, scale, indices, distances, found);
+        // scale = (1+epsilon)^2 prunes the far side unless it can be significantly closer
+        if (found < k || scale * delta * delta < distances[k - 1])
+            search(left_first ? mid + 1 : begin, left_first ? end : mid, key, scale, indices, distances, found);
+    }
+
+    std::size_t ChainIkSeedDatabase::findNearest(const Frame& pose, std::vector<std::size_t>& indices,
+                                                 std::vector<double>& distances, double epsilon) const
+    {
+        distances.resize(indices.size());
+        if (indices.empty())
+            return 0;
+        double key[KEY_SIZE];
+        toKey(pose, key);
+        std::size_t found = 0;
+        search(0, nr_of_samples, key, (1 + epsilon) * (1 + epsilon), indices, distances, found);
+        for (std::size_t i = 0; i < found; ++i)
+            distances[i] = std::sqrt(distances[i]);
+        return found;
+    }
+
+    double ChainIkSeedDatabase::distance(const Frame& pose1, const Frame& pose2) const
+    {
+        double key1[KEY_SIZE], key2[KEY_SIZE];
+        toKey(pose1, key1);
+        toKey(pose2, key2);
+        double d2 = 0;
+        for (std::size_t c = 0; c < KEY_SIZE; ++c)
+            d2 += (key1[c] - key2[c]) * (key1[c] - key2[c]);
+        return std::sqrt(d2);
+    }
+
+    void ChainIkSeedDatabase::getJointPositions(std::size_t index, JntArray& q) const
+    {
+        if (q.rows() != nr_of_joints)
+            q.resize(nr_of_joints);
+        for (unsigned int j = 0; j < nr_of_joints; ++j)
+            q(j) = positions[index * nr_of_joints + j];
+    }
+}
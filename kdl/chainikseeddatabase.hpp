@@ -0,0 +1,154 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDLCHAINIKSEEDDATABASE_HPP
+#define KDLCHAINIKSEEDDATABASE_HPP
+
+#include "chain.hpp"
+#include "frames.hpp"
+#include "jntarray.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace KDL
+{
+    /**
+     * \brief Database of (pose, joint positions) samples of a chain, used to
+     * seed iterative inverse position kinematics solvers.
+     *
+     * build() samples the joint space uniformly, computes the pose of the tip
+     * for every sample and sorts the samples into an implicit, balanced k-d
+     * tree.  findNearest() returns the samples whose tip pose is closest to a
+     * given pose, using the distance
+     * \f$ \sqrt{|p_1-p_2|^2 + s^2 (|x_1-x_2|^2 + |z_1-z_2|^2)} \f$
+     * with p the position, x and z the first and third column of the rotation
+     * and s the rotation scale (in meters per radian, for small angles).
+     *
+     * The tree is stored in flat arrays, so save() writes it as is and load()
+     * maps the file into memory without parsing it (POSIX systems; elsewhere
+     * the file is read).  The file is in native byte order.
+     *
+     * @ingroup KinematicFamily
+     */
+    class ChainIkSeedDatabase
+    {
+    public:
+        /// Number of coordinates of the key of a sample: 3 for the position, 6 for the rotation.
+        static const std::size_t KEY_SIZE = 9;
+
+        ChainIkSeedDatabase();
+        ~ChainIkSeedDatabase();
+
+        ChainIkSeedDatabase(const ChainIkSeedDatabase&) = delete;
+        ChainIkSeedDatabase& operator=(const ChainIkSeedDatabase&) = delete;
+
+        /**
+         * Samples the joint space of \a chain and builds the database,
+         * replacing the current content.
+         *
+         * @param chain the chain to sample
+         * @param nr_of_samples number of random joint configurations
+         * @param q_min, q_max box from which the configurations are sampled
+         * @param rotation_scale weight s of the rotation in the distance
+         * @param random_seed seed of the random generator, for reproducible databases
+         * @param nr_of_threads threads computing the forward kinematics, 0 selects
+         *        the number of hardware threads
+         * @return false if the sizes of q_min and q_max do not match the chain,
+         * or if the chain has no joints or more than 1024
+         */
+        bool build(const Chain& chain, std::size_t nr_of_samples,
+                   const JntArray& q_min, const JntArray& q_max,
+                   double rotation_scale=0.1, unsigned int random_seed=0,
+                   std::size_t nr_of_threads=0);
+
+        /**
+         * Same as above, sampling within the position limits of the joints.
+         * Joints without limits (lower >= upper) are sampled in [-pi, pi].
+         */
+        bool build(const Chain& chain, std::size_t nr_of_samples,
+                   double rotation_scale=0.1, unsigned int random_seed=0,
+                   std::size_t nr_of_threads=0);
+
+        /// Writes the database to \a filename, returns false on failure.
+        bool save(const std::string& filename) const;
+
+        /**
+         * Maps the database stored in \a filename into memory, replacing the
+         * current content.
+         * @return false if the file cannot be read or is not a valid database:
+         * the header must announce 1 to 1024 joints and exactly the
+         * samples that fill the rest of the file, and every split
+         * coordinate must index the key
+         */
+        bool load(const std::string& filename);
+
+        /**
+         * Finds the samples nearest to \a pose.
+         *
+         * @param pose the pose of the tip with respect to the base
+         * @param indices on input, its size is the number of samples to find;
+         *        on output, the indices of the samples sorted by increasing distance
+         * @param distances resized to the size of \a indices; the distances of the samples
+         * @param epsilon approximation: the i-th sample found is at most (1+epsilon)
+         *        times farther than the true i-th nearest sample.  Seeding does not need
+         *        the exact neighbours, and epsilon=1 makes the search several times faster.
+         * @return the number of samples found, min(indices.size(), getNrOfSamples())
+         */
+        std::size_t findNearest(const Frame& pose, std::vector<std::size_t>& indices,
+                                std::vector<double>& distances, double epsilon=0) const;
+
+        /// Distance between two poses, in the metric of the database.
+        double distance(const Frame& pose1, const Frame& pose2) const;
+
+        /// Copies the joint positions of sample \a index to \a q (resized if needed).
+        void getJointPositions(std::size_t index, JntArray& q) const;
+
+        std::size_t getNrOfSamples() const { return nr_of_samples; }
+        unsigned int getNrOfJoints() const { return nr_of_joints; }
+        double getRotationScale() const { return rotation_scale; }
+
+    private:
+        void clear();
+        void assign(const double* keys, const double* positions, const std::uint8_t* split);
+        void toKey(const Frame& pose, double* key) const;
+        void search(std::size_t begin, std::size_t end, const double* key, double scale,
+                    std::vector<std::size_t>& indices, std::vector<double>& distances,
+                    std::size_t& found) const;
+
+        std::size_t nr_of_samples;
+        unsigned int nr_of_joints;
+        double rotation_scale;
+
+        // the tree is sorted in place: the node of [begin, end) is sample (begin+end)/2,
+        // its children are [begin, mid) and [mid+1, end).
+        const double* keys;          // nr_of_samples x KEY_SIZE
+        const double* positions;     // nr_of_samples x nr_of_joints
+        const std::uint8_t* split;   // split coordinate of every node
+
+        // storage of a built or read database
+        std::vector<double> key_storage;
+        std::vector<double> position_storage;
+        std::vector<std::uint8_t> split_storage;
+
+        // storage of a mapped database
+        void* mapping;
+        std::size_t mapping_size;
+    };
+}
+
+#endif
@@ -0,0 +1,86 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainiksolverpos_batch.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace KDL
+{
+    ChainIkSolverPos_Batch::ThreadState::ThreadState(std::size_t nj) :
+        ws(nj), seed(nj), solution(nj)
+    {
+    }
+
+    ChainIkSolverPos_Batch::ChainIkSolverPos_Batch(const ChainIkSolverPos_LMA& _solver, std::size_t _nr_of_threads,
+                                                   std::size_t _block_size) :
+        solver(_solver),
+        pool(_nr_of_threads),
+        threads(pool.size(), ThreadState(solver.getNrOfJoints())),
+        block_size(_block_size > 0 ? _block_size : 1),
+        last_nr_of_solutions(0)
+    {
+    }
+
+    ChainIkSolverPos_Batch::~ChainIkSolverPos_Batch()
+    {
+    }
+
+    void ChainIkSolverPos_Batch::updateInternalDataStructures()
+    {
+        const std::size_t nj = solver.getNrOfJoints();
+        for (std::size_t t = 0; t < threads.size(); ++t) {
+            threads[t].ws.resize(nj);
+            threads[t].seed.resize(nj);
+            threads[t].solution.resize(nj);
+        }
+    }
+
+    int ChainIkSolverPos_Batch::CartToJnt(const std::vector<Frame>& targets, const Eigen::MatrixXd& seeds,
+                                          Eigen::MatrixXd& solutions, std::vector<int>& codes, std::vector<int>& nr_of_iter)
+    {
+        const std::size_t nj = solver.getNrOfJoints();
+        const std::size_t n = targets.size();
+        if ((std::size_t)seeds.rows() != nj || (seeds.cols() != 1 && (std::size_t)seeds.cols() != n) ||
+            (std::size_t)solutions.rows() != nj || (std::size_t)solutions.cols() != n ||
+            codes.size() != n || nr_of_iter.size() != n ||
+            (std::size_t)threads[0].seed.rows() != nj)
+            return (error = E_SIZE_MISMATCH);
+
+        const bool common_seed = seeds.cols() == 1 && n != 1;
+        pool.parallel_for((n + block_size - 1) / block_size, [&](std::size_t block, std::size_t t) {
+            ThreadState& state = threads[t];
+            const std::size_t end = std::min(n, (block + 1) * block_size);
+            for (std::size_t k = block * block_size; k < end; ++k) {
+                state.seed.data = seeds.col(common_seed ? 0 : k);
+#ifdef KDL_SOLVER_TELEMETRY
+                const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+#endif
+                codes[k] = solver.CartToJnt(state.seed, targets[k], state.solution, state.ws);
+                nr_of_iter[k] = state.ws.lastNrOfIter;
+#ifdef KDL_SOLVER_TELEMETRY
+                telemetry.record(codes[k], static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now() - start).count()), nr_of_iter[k]);
+#endif
+                solutions.col(k) = state.solution.data;
+            }
+        });
+
+        last_nr_of_solutions = std::count(codes.begin(), codes.end(), (int)E_NOERROR);
+        return (error = last_nr_of_solutions == n ? E_NOERROR : E_NO_CONVERGE);
+    }
+}
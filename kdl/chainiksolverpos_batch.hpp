@@ -0,0 +1,98 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDLCHAINIKSOLVERPOS_BATCH_HPP
+#define KDLCHAINIKSOLVERPOS_BATCH_HPP
+
+#include "chainiksolverpos_lma.hpp"
+#include "utilities/thread_pool.hpp"
+
+#include <vector>
+
+namespace KDL {
+
+    /**
+     * Inverse position kinematics for many targets at once, e.g. for
+     * reachability studies.
+     *
+     * The targets are split into blocks of consecutive targets that the
+     * threads of a ThreadPool take as they become idle, so that targets that
+     * need many iterations do not hold up the others.  Every thread solves
+     * its targets with the const CartToJnt of a ChainIkSolverPos_LMA (or
+     * ChainIkSolverPos_LMA_JL) and its own workspace, which is reused for
+     * all targets: solving a batch does not allocate memory.
+     *
+     * With KDL_SOLVER_TELEMETRY, every target is recorded as a call in the
+     * telemetry of this solver.
+     *
+     * @ingroup KinematicFamily
+     */
+    class ChainIkSolverPos_Batch : public SolverI
+    {
+    public:
+        /**
+         * @param solver the configured solver used for every target; it is
+         *        not modified and must outlive this object.
+         * @param nr_of_threads number of threads, including the calling thread.
+         *        0 selects the number of hardware threads.
+         * @param block_size number of consecutive targets handed to a thread at once.
+         */
+        explicit ChainIkSolverPos_Batch(const ChainIkSolverPos_LMA& solver, std::size_t nr_of_threads=0,
+                                        std::size_t block_size=32);
+        ~ChainIkSolverPos_Batch();
+
+        /**
+         * Solves the inverse position kinematics of every target.
+         *
+         * @param targets the poses of the tip with respect to the base
+         * @param seeds initial joint positions, one column per target, or a
+         *        single column used for all targets
+         * @param solutions receives the joint positions, one column per target
+         *        (not resized)
+         * @param codes receives the error code of every target (not resized)
+         * @param nr_of_iter receives the number of iterations of every target (not resized)
+         * @return E_NOERROR if all targets converged, E_NO_CONVERGE if some did not,
+         *         E_SIZE_MISMATCH if the sizes of the arguments do not match.
+         */
+        int CartToJnt(const std::vector<Frame>& targets, const Eigen::MatrixXd& seeds,
+                      Eigen::MatrixXd& solutions, std::vector<int>& codes, std::vector<int>& nr_of_iter);
+
+        /// Number of targets that converged during the last call.
+        std::size_t getLastNrOfSolutions() const { return last_nr_of_solutions; }
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+    private:
+        // state of one thread: its workspace and the seed/solution of its current target
+        struct ThreadState
+        {
+            explicit ThreadState(std::size_t nj);
+            ChainIkSolverPos_LMA::Workspace ws;
+            JntArray seed;
+            JntArray solution;
+        };
+
+        const ChainIkSolverPos_LMA& solver;
+        ThreadPool pool;
+        std::vector<ThreadState> threads;
+        std::size_t block_size;
+        std::size_t last_nr_of_solutions;
+    };
+
+}
+
+#endif
@@ -29,11 +29,14 @@
  ***************************************************************************/
 
 #include "chainiksolverpos_lma.hpp"
+#include <algorithm>
 #include <iostream>
+#include <limits>
 
 namespace KDL {
 
-
+const int ChainIkSolverPos_LMA::SOLVE_SVD;
+const int ChainIkSolverPos_LMA::SOLVE_CHOLESKY;
 
 
 template <typename Derived>
@@ -47,6 +50,61 @@ inline void Twist_to_Eigen(const KDL::Twist& t,Eigen::MatrixBase<Derived>& e) {
 }
 
 
+ChainIkSolverPos_LMA::Workspace::Workspace(std::size_t nj) :
+	lastNrOfIter(0),
+	lastDifference(0),
+	lastTransDiff(0),
+	lastRotDiff(0),
+	lastSV(nj>6?6:nj),
+	lastNrOfWaypoints(0),
+	jac(6, nj),
+	grad(nj),
+	T_base_jointroot(nj),
+	T_base_jointtip(nj),
+	q(nj),
+	G(nj>6?6:nj, nj>6?6:nj),
+	A(nj>6?6:nj, nj>6?6:nj),
+	rhs(nj>6?6:nj),
+	tmp(nj),
+	ldlt(nj>6?6:nj),
+	svd(6, nj, Eigen::ComputeThinU | Eigen::ComputeThinV),
+	diffq(nj),
+	q_new(nj),
+	original_Aii(nj>6?6:nj),
+	free_joints(VectorXq::Ones(nj)),
+	jac_free(6, nj),
+	q_path_seed(nj),
+	q_path_out(nj),
+	cancel(nullptr),
+	deadline(std::chrono::steady_clock::time_point::max())
+{}
+
+ChainIkSolverPos_LMA::Workspace::Workspace(const ChainIkSolverPos_LMA& solver) :
+	Workspace(solver.getNrOfJoints())
+{}
+
+void ChainIkSolverPos_LMA::Workspace::resize(std::size_t nj) {
+    lastSV.conservativeResize(nj>6?6:nj);
+    jac.conservativeResize(Eigen::NoChange, nj);
+    grad.conservativeResize(nj);
+    T_base_jointroot.resize(nj);
+    T_base_jointtip.resize(nj);
+    q.conservativeResize(nj);
+    G.conservativeResize(nj>6?6:nj, nj>6?6:nj);
+    A.conservativeResize(nj>6?6:nj, nj>6?6:nj);
+    rhs.conservativeResize(nj>6?6:nj);
+    tmp.conservativeResize(nj);
+    ldlt = Eigen::LDLT<MatrixXq>(nj>6?6:nj);
+    svd = Eigen::JacobiSVD<MatrixXq>(6, nj, Eigen::ComputeThinU | Eigen::ComputeThinV);
+    diffq.conservativeResize(nj);
+    q_new.conservativeResize(nj);
+    original_Aii.conservativeResize(nj>6?6:nj);
+    free_joints.setOnes(nj);
+    jac_free.conservativeResize(Eigen::NoChange, nj);
+    q_path_seed.resize(nj);
+    q_path_out.resize(nj);
+}
+
 ChainIkSolverPos_LMA::ChainIkSolverPos_LMA(
 		const KDL::Chain& _chain,
 		const Eigen::Matrix<double,6,1>& _L,
@@ -54,14 +112,35 @@ ChainIkSolverPos_LMA::ChainIkSolverPos_LMA(
 		int _maxiter,
 		double _eps_joints
 ) :
-    chain(_chain),
+    ChainIkSolverPos_LMA(std::make_shared<const Chain>(_chain), _L, _eps, _maxiter, _eps_joints)
+{}
+
+ChainIkSolverPos_LMA::ChainIkSolverPos_LMA(
+		const KDL::Chain& _chain,
+		double _eps,
+		int _maxiter,
+		double _eps_joints
+) :
+    ChainIkSolverPos_LMA(std::make_shared<const Chain>(_chain), _eps, _maxiter, _eps_joints)
+{}
+
+ChainIkSolverPos_LMA::ChainIkSolverPos_LMA(
+		const ChainConstPtr& _chain,
+		const Eigen::Matrix<double,6,1>& _L,
+		double _eps,
+		int _maxiter,
+		double _eps_joints
+) :
+    chain_ptr(_chain),
+    chain(*chain_ptr),
 	nj(chain.getNrOfJoints()),
 	ns(chain.getNrOfSegments()),
 	lastNrOfIter(0),
 	lastDifference(0),
 	lastTransDiff(0),
 	lastRotDiff(0),
-	lastSV(nj),
+	lastSV(nj>6?6:nj),
+	lastNrOfWaypoints(0),
 	jac(6, nj),
 	grad(nj),
 	display_information(false),
@@ -69,25 +148,20 @@ ChainIkSolverPos_LMA::ChainIkSolverPos_LMA(
 	eps(_eps),
 	eps_joints(_eps_joints),
 	L(_L.cast<ScalarType>()),
-	T_base_jointroot(nj),
-	T_base_jointtip(nj),
-	q(nj),
-	A(nj, nj),
-	tmp(nj),
-	ldlt(nj),
-	svd(6, nj),
-	diffq(nj),
-	q_new(nj),
-	original_Aii(nj)
+	solve_method(SOLVE_SVD),
+	compute_singular_values(false),
+	time_budget(0),
+	ws_(nj)
 {}
 
 ChainIkSolverPos_LMA::ChainIkSolverPos_LMA(
-		const KDL::Chain& _chain,
+		const ChainConstPtr& _chain,
 		double _eps,
 		int _maxiter,
 		double _eps_joints
 ) :
-    chain(_chain),
+    chain_ptr(_chain),
+    chain(*chain_ptr),
     nj(chain.getNrOfJoints()),
     ns(chain.getNrOfSegments()),
 	lastNrOfIter(0),
@@ -95,21 +169,17 @@ ChainIkSolverPos_LMA::ChainIkSolverPos_LMA(
     lastTransDiff(0),
 	lastRotDiff(0),
 	lastSV(nj>6?6:nj),
+	lastNrOfWaypoints(0),
 	jac(6, nj),
 	grad(nj),
 	display_information(false),
 	maxiter(_maxiter),
 	eps(_eps),
 	eps_joints(_eps_joints),
-	T_base_jointroot(nj),
-	T_base_jointtip(nj),
-	q(nj),
-	A(nj, nj),
-	ldlt(nj),
-	svd(6, nj),
-	diffq(nj),
-	q_new(nj),
-	original_Aii(nj)
+	solve_method(SOLVE_SVD),
+	compute_singular_values(false),
+	time_budget(0),
+	ws_(nj)
 {
 	L(0)=1;
 	L(1)=1;
@@ -125,75 +195,109 @@ void ChainIkSolverPos_LMA::updateInternalDataStructures() {
     lastSV.conservativeResize(nj>6?6:nj);
     jac.conservativeResize(Eigen::NoChange, nj);
     grad.conservativeResize(nj);
-    T_base_jointroot.resize(nj);
-    T_base_jointtip.resize(nj);
-    q.conservativeResize(nj);
-    A.conservativeResize(nj, nj);
-    ldlt = Eigen::LDLT<MatrixXq>(nj);
-    svd = Eigen::JacobiSVD<MatrixXq>(6, nj);
-    diffq.conservativeResize(nj);
-    q_new.conservativeResize(nj);
-    original_Aii.conservativeResize(nj);
+    ws_.resize(nj);
 }
 
 ChainIkSolverPos_LMA::~ChainIkSolverPos_LMA() {}
 
-void ChainIkSolverPos_LMA::compute_fwdpos(const VectorXq& q) {
+void ChainIkSolverPos_LMA::compute_fwdpos(const VectorXq& q, Workspace& ws) const {
 	using namespace KDL;
 	std::size_t jointndx=0;
-	T_base_head = Frame::Identity(); // frame w.r.t. base of head
+	ws.T_base_head = Frame::Identity(); // frame w.r.t. base of head
 	for (std::size_t i=0;i<chain.getNrOfSegments();i++) {
 		const Segment& segment = chain.getSegment(i);
         if (segment.getJoint().getType()!=Joint::Fixed) {
-			T_base_jointroot[jointndx] = T_base_head;
-			T_base_head = T_base_head * segment.pose(q(jointndx));
-			T_base_jointtip[jointndx] = T_base_head;
+			ws.T_base_jointroot[jointndx] = ws.T_base_head;
+			ws.T_base_head = ws.T_base_head * segment.pose(q(jointndx));
+			ws.T_base_jointtip[jointndx] = ws.T_base_head;
 			jointndx++;
 		} else {
-			T_base_head = T_base_head * segment.pose(0.0);
+			ws.T_base_head = ws.T_base_head * segment.pose(0.0);
 		}
 	}
 }
 
-void ChainIkSolverPos_LMA::compute_jacobian(const VectorXq& q) {
+void ChainIkSolverPos_LMA::compute_jacobian(const VectorXq& q, Workspace& ws) const {
 	using namespace KDL;
 	std::size_t jointndx=0;
 	for (std::size_t i=0;i<chain.getNrOfSegments();i++) {
 		const Segment& segment = chain.getSegment(i);
         if (segment.getJoint().getType()!=Joint::Fixed) {
 			// compute twist of the end effector motion caused by joint [jointndx]; expressed in base frame, with vel. ref. point equal to the end effector
-			KDL::Twist t = ( T_base_jointroot[jointndx].M * segment.twist(q(jointndx),1.0) ).RefPoint( T_base_head.p - T_base_jointtip[jointndx].p);
-			jac(0,jointndx)=t[0];
-			jac(1,jointndx)=t[1];
-			jac(2,jointndx)=t[2];
-			jac(3,jointndx)=t[3];
-			jac(4,jointndx)=t[4];
-			jac(5,jointndx)=t[5];
+			KDL::Twist t = ( ws.T_base_jointroot[jointndx].M * segment.twist(q(jointndx),1.0) ).RefPoint( ws.T_base_head.p - ws.T_base_jointtip[jointndx].p);
+			ws.jac(0,jointndx)=t[0];
+			ws.jac(1,jointndx)=t[1];
+			ws.jac(2,jointndx)=t[2];
+			ws.jac(3,jointndx)=t[3];
+			ws.jac(4,jointndx)=t[4];
+			ws.jac(5,jointndx)=t[5];
 			jointndx++;
 		}
 	}
 }
 
+void ChainIkSolverPos_LMA::compute_fwdpos(const VectorXq& q) {
+	compute_fwdpos(q, ws_);
+	T_base_head = ws_.T_base_head;
+}
+
+void ChainIkSolverPos_LMA::compute_jacobian(const VectorXq& q) {
+	compute_jacobian(q, ws_);
+	jac = ws_.jac;
+}
+
+void ChainIkSolverPos_LMA::copy_diagnostics() {
+	lastNrOfIter   = ws_.lastNrOfIter;
+	lastDifference = ws_.lastDifference;
+	lastTransDiff  = ws_.lastTransDiff;
+	lastRotDiff    = ws_.lastRotDiff;
+	lastSV         = ws_.lastSV;
+	lastNrOfWaypoints = ws_.lastNrOfWaypoints;
+	jac            = ws_.jac;
+	grad           = ws_.grad;
+	T_base_head    = ws_.T_base_head;
+}
+
 void ChainIkSolverPos_LMA::display_jac(const KDL::JntArray& jval) {
 	VectorXq q;
 	q = jval.data.cast<ScalarType>();
 	compute_fwdpos(q);
 	compute_jacobian(q);
-	svd.compute(jac);
-	std::cout << "Singular values : " << svd.singularValues().transpose()<<"\n";
+	ws_.svd.compute(jac);
+	std::cout << "Singular values : " << ws_.svd.singularValues().transpose()<<"\n";
 }
 
 
 int ChainIkSolverPos_LMA::CartToJnt(const KDL::JntArray& q_init, const KDL::Frame& T_base_goal, KDL::JntArray& q_out) {
+  KDL_SOLVER_TELEMETRY_SCOPE_ITER(lastNrOfIter);
   if (nj != chain.getNrOfJoints())
     return (error = E_NOT_UP_TO_DATE);
 
+  error = CartToJnt(q_init, T_base_goal, q_out, ws_);
+  copy_diagnostics();
+  return error;
+}
+
+int ChainIkSolverPos_LMA::CartToJnt(const KDL::JntArray& q_init, const KDL::Frame& T_base_goal, KDL::JntArray& q_out, Workspace& ws) const {
+  const VectorXq* q_min;
+  const VectorXq* q_max;
+  getBounds(q_min, q_max);
+  return solve(q_init, T_base_goal, q_out, ws, q_min, q_max);
+}
+
+int ChainIkSolverPos_LMA::solve(const KDL::JntArray& q_init, const KDL::Frame& T_base_goal, KDL::JntArray& q_out, Workspace& ws,
+                                const VectorXq* q_min, const VectorXq* q_max, double lambda_init, std::size_t iterations) const {
+  if (nj != chain.getNrOfJoints())
+    return E_NOT_UP_TO_DATE;
+
   if (nj != q_init.rows() || nj != q_out.rows())
-    return (error = E_SIZE_MISMATCH);
+    return E_SIZE_MISMATCH;
+
+  if (nj != (std::size_t)ws.q.rows() || nj != ws.T_base_jointroot.size())
+    return E_SIZE_MISMATCH;
 
 	using namespace KDL;
 	double v      = 2;
-	double tau    = 10;
 	double rho;
 	double lambda;
 	Twist t;
@@ -201,101 +305,216 @@ int ChainIkSolverPos_LMA::CartToJnt(const KDL::JntArray& q_init, const KDL::Fram
 	Eigen::Matrix<ScalarType,6,1> delta_pos;
 	Eigen::Matrix<ScalarType,6,1> delta_pos_new;
 
+	VectorXq& q = ws.q;
+	MatrixXq& jac = ws.jac;
+	VectorXq& grad = ws.grad;
+	VectorXq& tmp = ws.tmp;
+	VectorXq& diffq = ws.diffq;
+	VectorXq& q_new = ws.q_new;
+	VectorXq& original_Aii = ws.original_Aii;
+	Eigen::JacobiSVD<MatrixXq>& svd = ws.svd;
+	const KDL::Frame& T_base_head = ws.T_base_head;
+	const bool use_svd = solve_method == SOLVE_SVD;
+	const bool bounded = q_min && q_max;
+	const MatrixXq& J = bounded ? ws.jac_free : jac;
+
+	// with SOLVE_SVD the decomposition of the last Jacobian is usually available,
+	// with SOLVE_CHOLESKY it is only computed on request.
+	auto store_singular_values = [&](bool svd_valid) {
+		if (!svd_valid) {
+			if (!use_svd && !compute_singular_values)
+				return;
+			svd.compute(jac);
+		}
+		ws.lastSV = svd.singularValues();
+	};
 
 	q=q_init.data.cast<ScalarType>();
-	compute_fwdpos(q);
+	if (bounded) {
+		q = q.cwiseMax(*q_min).cwiseMin(*q_max);
+		ws.free_joints.setOnes();
+	}
+	compute_fwdpos(q, ws);
 	Twist_to_Eigen( diff( T_base_head, T_base_goal), delta_pos );
 	delta_pos=L.asDiagonal()*delta_pos;
 	delta_pos_norm = delta_pos.norm();
 	if (delta_pos_norm<eps) {
-		lastNrOfIter    =0 ;
+		ws.lastNrOfIter    =0 ;
 		Twist_to_Eigen( diff( T_base_head, T_base_goal), delta_pos );
-		lastDifference  = delta_pos.norm();
-		lastTransDiff   = delta_pos.topRows(3).norm();
-		lastRotDiff     = delta_pos.bottomRows(3).norm();
-		svd.compute(jac);
-		original_Aii    = svd.singularValues();
-		lastSV          = svd.singularValues();
+		ws.lastDifference  = delta_pos.norm();
+		ws.lastTransDiff   = delta_pos.topRows(3).norm();
+		ws.lastRotDiff     = delta_pos.bottomRows(3).norm();
+		if (use_svd || compute_singular_values) {
+			compute_jacobian(q, ws);
+			jac = L.asDiagonal()*jac;
+		}
+		store_singular_values(false);
 		q_out.data      = q.cast<double>();
-		return (error = E_NOERROR);
+		return E_NOERROR;
 	}
-	compute_jacobian(q);
+	compute_jacobian(q, ws);
 	jac = L.asDiagonal()*jac;
 
-	lambda = tau;
+	lambda = lambda_init;
 	double dnorm = 1;
-	for (std::size_t i=0;i<maxiter;++i) {
+	// the decomposition (SVD or normal equations) and the gradient only change
+	// when a step is accepted; a rejected step only changes lambda.
+	bool jac_changed = true;
+	std::chrono::steady_clock::time_point deadline = ws.deadline;
+	if (time_budget > 0)
+		deadline = std::min(deadline, std::chrono::steady_clock::now() +
+		           std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::micro>(time_budget)));
+	const bool timed = deadline != std::chrono::steady_clock::time_point::max();
+	const std::size_t max_iterations = iterations > 0 ? iterations : maxiter;
+	for (std::size_t i=0;i<max_iterations;++i) {
+		const bool cancelled = ws.cancel && ws.cancel->load(std::memory_order_relaxed);
+		if (cancelled || (timed && std::chrono::steady_clock::now() > deadline)) {
+			// q is the best configuration so far, steps are only accepted when they reduce the error
+			compute_fwdpos(q, ws);
+			Twist_to_Eigen( diff( T_base_head, T_base_goal), delta_pos );
+			ws.lastDifference = delta_pos_norm;
+			ws.lastTransDiff  = delta_pos.topRows(3).norm();
+			ws.lastRotDiff    = delta_pos.bottomRows(3).norm();
+			ws.lastNrOfIter   = i;
+			store_singular_values(false);
+			q_out.data     = q.cast<double>();
+			return cancelled ? E_ABORTED : E_TIMEOUT;
+		}
 
-		svd.compute(jac);
-		original_Aii = svd.singularValues();
-		for (std::size_t j=0;j<original_Aii.rows();++j) {
-			original_Aii(j) = original_Aii(j)/( original_Aii(j)*original_Aii(j)+lambda);
+		bool decompose = jac_changed;
+		if (jac_changed)
+			grad.noalias() = jac.transpose()*delta_pos;
+		if (bounded) {
+			// active set: joints on a bound that the gradient pushes outwards
+			for (std::size_t j=0;j<nj;++j) {
+				const ScalarType is_free = ((q(j) <= (*q_min)(j) && grad(j) < 0) ||
+				                            (q(j) >= (*q_max)(j) && grad(j) > 0)) ? 0 : 1;
+				if (is_free != ws.free_joints(j)) {
+					ws.free_joints(j) = is_free;
+					decompose = true;
+				}
+			}
+			if (decompose)
+				ws.jac_free.noalias() = jac*ws.free_joints.asDiagonal();
+		}
+		if (decompose) {
+			if (use_svd) {
+				svd.compute(J);
+			} else if (nj<=6) {
+				ws.G.noalias() = J.transpose()*J;
+			} else {
+				ws.G.noalias() = J*J.transpose();
+			}
+			jac_changed = false;
+		}
+		if (use_svd) {
+			original_Aii = svd.singularValues();
+			for (std::size_t j=0;j<original_Aii.rows();++j) {
+				original_Aii(j) = original_Aii(j)/( original_Aii(j)*original_Aii(j)+lambda);
 
+			}
+			tmp.head(original_Aii.rows()).noalias() = svd.matrixU().transpose()*delta_pos;
+			tmp.head(original_Aii.rows()) = original_Aii.cwiseProduct(tmp.head(original_Aii.rows()));
+			diffq.noalias() = svd.matrixV()*tmp.head(original_Aii.rows());
+		} else {
+			// (J^T J + lambda I) dq = J^T e, or dq = J^T (J J^T + lambda I)^-1 e for nj>6
+			ws.A = ws.G;
+			ws.A.diagonal().array() += lambda;
+			ws.ldlt.compute(ws.A);
+			if (nj<=6) {
+				if (bounded) {
+					tmp = grad.cwiseProduct(ws.free_joints);
+					diffq = ws.ldlt.solve(tmp);
+				} else {
+					diffq = ws.ldlt.solve(grad);
+				}
+			} else {
+				ws.rhs = ws.ldlt.solve(delta_pos);
+				diffq.noalias() = J.transpose()*ws.rhs;
+			}
+		}
+		if (bounded) {
+			// project the step into the box; from here on diffq is the projected step
+			q_new = (q+diffq).cwiseMax(*q_min).cwiseMin(*q_max);
+			diffq = q_new-q;
 		}
-		tmp = svd.matrixU().transpose()*delta_pos;
-		tmp = original_Aii.cwiseProduct(tmp);
-		diffq = svd.matrixV()*tmp;
-		grad = jac.transpose()*delta_pos;
 		if (display_information) {
 			std::cout << "------- iteration " << i << " ----------------\n"
 					  << "  q              = " << q.transpose() << "\n"
 					  << "  weighted jac   = \n" << jac << "\n"
-					  << "  lambda         = " << lambda << "\n"
-					  << "  eigenvalues    = " << svd.singularValues().transpose() << "\n"
-					  << "  difference     = "   << delta_pos.transpose() << "\n"
+					  << "  lambda         = " << lambda << "\n";
+			if (use_svd)
+				std::cout << "  eigenvalues    = " << svd.singularValues().transpose() << "\n";
+			std::cout << "  difference     = "   << delta_pos.transpose() << "\n"
 					  << "  difference norm= "   << delta_pos_norm << "\n"
 					  << "  proj. on grad. = "   << grad << "\n";
 			std::cout << std::endl;
 		}
 		dnorm = diffq.lpNorm<Eigen::Infinity>();
 		if (dnorm < eps_joints) {
-				lastDifference = delta_pos_norm;
-				lastNrOfIter   = i;
-				lastSV         = svd.singularValues();
+				ws.lastDifference = delta_pos_norm;
+				ws.lastNrOfIter   = i;
+				store_singular_values(use_svd);
 				q_out.data     = q.cast<double>();
-				compute_fwdpos(q);
+				compute_fwdpos(q, ws);
 				Twist_to_Eigen( diff( T_base_head, T_base_goal), delta_pos );
-				lastTransDiff  = delta_pos.topRows(3).norm();
-				lastRotDiff    = delta_pos.bottomRows(3).norm();
-				return (error = E_INCREMENT_JOINTS_TOO_SMALL);
+				ws.lastTransDiff  = delta_pos.topRows(3).norm();
+				ws.lastRotDiff    = delta_pos.bottomRows(3).norm();
+				return E_INCREMENT_JOINTS_TOO_SMALL;
 		}
 
 
-		if (grad.transpose()*grad < eps_joints*eps_joints ) {
-			compute_fwdpos(q);
+		if ((bounded ? grad.cwiseProduct(ws.free_joints).squaredNorm() : grad.squaredNorm()) < eps_joints*eps_joints ) {
+			compute_fwdpos(q, ws);
 			Twist_to_Eigen( diff( T_base_head, T_base_goal), delta_pos );
-			lastDifference = delta_pos_norm;
-			lastTransDiff = delta_pos.topRows(3).norm();
-			lastRotDiff   = delta_pos.bottomRows(3).norm();
-			lastSV        = svd.singularValues();
-			lastNrOfIter  = i;
+			ws.lastDifference = delta_pos_norm;
+			ws.lastTransDiff = delta_pos.topRows(3).norm();
+			ws.lastRotDiff   = delta_pos.bottomRows(3).norm();
+			store_singular_values(use_svd);
+			ws.lastNrOfIter  = i;
 			q_out.data    = q.cast<double>();
-			return (error = E_GRADIENT_JOINTS_TOO_SMALL);
+			return E_GRADIENT_JOINTS_TOO_SMALL;
 		}
 
-		q_new = q+diffq;
-		compute_fwdpos(q_new);
+		if (!bounded)
+			q_new = q+diffq;
+		compute_fwdpos(q_new, ws);
 		Twist_to_Eigen( diff( T_base_head, T_base_goal), delta_pos_new );
 		delta_pos_new             = L.asDiagonal()*delta_pos_new;
 		double delta_pos_new_norm = delta_pos_new.norm();
 		rho                       = delta_pos_norm*delta_pos_norm - delta_pos_new_norm*delta_pos_new_norm;
-		rho                      /= diffq.transpose()*(lambda*diffq + grad);
+		if (bounded) {
+			// the projected step is not the Levenberg-Marquardt step, use the reduction
+			// predicted by the linear model: |e|^2 - |e - J d|^2
+			Eigen::Matrix<ScalarType,6,1> e_pred = delta_pos;
+			e_pred.noalias() -= jac*diffq;
+			const double predicted = delta_pos_norm*delta_pos_norm - e_pred.squaredNorm();
+			// after the projection the model may predict no reduction at all:
+			// reject the step and increase lambda
+			if (predicted > std::numeric_limits<double>::epsilon()*delta_pos_norm*delta_pos_norm)
+				rho /= predicted;
+			else
+				rho = -1;
+		} else {
+			rho /= diffq.transpose()*(lambda*diffq + grad);
+		}
 		if (rho > 0) {
 			q               = q_new;
 			delta_pos       = delta_pos_new;
 			delta_pos_norm  = delta_pos_new_norm;
 			if (delta_pos_norm<eps) {
 				Twist_to_Eigen( diff( T_base_head, T_base_goal), delta_pos );
-				lastDifference = delta_pos_norm;
-				lastTransDiff  = delta_pos.topRows(3).norm();
-				lastRotDiff    = delta_pos.bottomRows(3).norm();
-				lastSV         = svd.singularValues();
-				lastNrOfIter   = i;
+				ws.lastDifference = delta_pos_norm;
+				ws.lastTransDiff  = delta_pos.topRows(3).norm();
+				ws.lastRotDiff    = delta_pos.bottomRows(3).norm();
+				store_singular_values(use_svd);
+				ws.lastNrOfIter   = i;
 				q_out.data     = q.cast<double>();
-				return (error = E_NOERROR);
+				return E_NOERROR;
 			}
-			compute_jacobian(q_new);
+			compute_jacobian(q_new, ws);
 			jac = L.asDiagonal()*jac;
+			jac_changed = true;
 			double tmp=2*rho-1;
 			lambda = lambda*max(1/3.0, 1-tmp*tmp*tmp);
 			v = 2;
@@ -304,20 +523,146 @@ int ChainIkSolverPos_LMA::CartToJnt(const KDL::JntArray& q_init, const KDL::Fram
 			v      = 2*v;
 		}
 	}
-	lastDifference = delta_pos_norm;
-	lastTransDiff  = delta_pos.topRows(3).norm();
-	lastRotDiff    = delta_pos.bottomRows(3).norm();
-	lastSV         = svd.singularValues();
-	lastNrOfIter   = maxiter;
+	ws.lastDifference = delta_pos_norm;
+	ws.lastTransDiff  = delta_pos.topRows(3).norm();
+	ws.lastRotDiff    = delta_pos.bottomRows(3).norm();
+	store_singular_values(use_svd);
+	ws.lastNrOfIter   = max_iterations;
 	q_out.data     = q.cast<double>();
-	return (error = E_MAX_ITERATIONS_EXCEEDED);
+	return E_MAX_ITERATIONS_EXCEEDED;
+
+}
+
+void ChainIkSolverPos_LMA::getBounds(const VectorXq*& q_min, const VectorXq*& q_max) const {
+	q_min = nullptr;
+	q_max = nullptr;
+}
+
+int ChainIkSolverPos_LMA::CartToJntPath(const KDL::JntArray& q_init, const std::vector<KDL::Frame>& path, Eigen::MatrixXd& q_path) {
+	KDL_SOLVER_TELEMETRY_SCOPE_ITER(lastNrOfIter);
+	if (nj != chain.getNrOfJoints())
+		return (error = E_NOT_UP_TO_DATE);
+
+	error = solve_path(q_init, path, nullptr, 0, q_path, ws_);
+	copy_diagnostics();
+	return error;
+}
+
+int ChainIkSolverPos_LMA::CartToJntPath(const KDL::JntArray& q_init, const std::vector<KDL::Frame>& path,
+                                        const std::vector<KDL::Twist>& twists, double dt, Eigen::MatrixXd& q_path) {
+	KDL_SOLVER_TELEMETRY_SCOPE_ITER(lastNrOfIter);
+	if (nj != chain.getNrOfJoints())
+		return (error = E_NOT_UP_TO_DATE);
+
+	error = solve_path(q_init, path, &twists, dt, q_path, ws_);
+	copy_diagnostics();
+	return error;
+}
+
+int ChainIkSolverPos_LMA::CartToJntPath(const KDL::JntArray& q_init, const std::vector<KDL::Frame>& path, Eigen::MatrixXd& q_path,
+                                        Workspace& ws) const {
+	return solve_path(q_init, path, nullptr, 0, q_path, ws);
+}
+
+int ChainIkSolverPos_LMA::CartToJntPath(const KDL::JntArray& q_init, const std::vector<KDL::Frame>& path,
+                                        const std::vector<KDL::Twist>& twists, double dt, Eigen::MatrixXd& q_path,
+                                        Workspace& ws) const {
+	return solve_path(q_init, path, &twists, dt, q_path, ws);
+}
+
+int ChainIkSolverPos_LMA::solve_path(const KDL::JntArray& q_init, const std::vector<KDL::Frame>& path,
+                                     const std::vector<KDL::Twist>* twists, double dt, Eigen::MatrixXd& q_path,
+                                     Workspace& ws) const {
+	if (nj != chain.getNrOfJoints())
+		return E_NOT_UP_TO_DATE;
+
+	if (nj != (std::size_t)q_path.rows() || path.size() != (std::size_t)q_path.cols() ||
+	    (twists && twists->size() != path.size()) ||
+	    nj != (std::size_t)ws.q_path_seed.rows() || nj != (std::size_t)ws.q_path_out.rows())
+		return E_SIZE_MISMATCH;
+
+	// damping of the predictor, and initial damping and number of iterations of the corrector:
+	// the predicted position is close to the solution, so the corrector starts (almost) as Gauss-Newton.
+	const double predictor_lambda = 1E-6;
+	const double corrector_lambda = 1E-3;
+	const std::size_t corrector_iterations = 10;
+
+	const VectorXq* q_min;
+	const VectorXq* q_max;
+	getBounds(q_min, q_max);
+	KDL::JntArray& seed = ws.q_path_seed;
+	KDL::JntArray& q_out = ws.q_path_out;
+	Eigen::Matrix<ScalarType,6,1> delta_pos;
+	std::size_t nr_of_iter = 0;
+
+	ws.lastNrOfWaypoints = 0;
+	ws.lastNrOfIter = 0;
+	for (std::size_t k=0;k<path.size();++k) {
+		int rc;
+		if (k == 0) {
+			rc = solve(q_init, path[0], q_out, ws, q_min, q_max);
+		} else {
+			// predictor: damped least-squares step for the displacement from the pose reached
+			// at the previous waypoint to the next one, with the weighted Jacobian of the last
+			// iterate of the previous waypoint.
+			if (twists)
+				Twist_to_Eigen( diff( ws.T_base_head, path[k-1]) + ((*twists)[k-1] + (*twists)[k])*(dt/2), delta_pos );
+			else
+				Twist_to_Eigen( diff( ws.T_base_head, path[k]), delta_pos );
+			delta_pos = L.asDiagonal()*delta_pos;
+			if (nj<=6) {
+				ws.A.noalias() = ws.jac.transpose()*ws.jac;
+				ws.A.diagonal().array() += predictor_lambda;
+				ws.ldlt.compute(ws.A);
+				ws.tmp.noalias() = ws.jac.transpose()*delta_pos;
+				ws.diffq = ws.ldlt.solve(ws.tmp);
+			} else {
+				ws.A.noalias() = ws.jac*ws.jac.transpose();
+				ws.A.diagonal().array() += predictor_lambda;
+				ws.ldlt.compute(ws.A);
+				ws.rhs = ws.ldlt.solve(delta_pos);
+				ws.diffq.noalias() = ws.jac.transpose()*ws.rhs;
+			}
+			seed.data = q_out.data + ws.diffq.cast<double>();
+
+			// corrector, falling back to the full iterations from the previous solution
+			rc = solve(seed, path[k], q_out, ws, q_min, q_max, corrector_lambda, corrector_iterations);
+			if (rc != E_NOERROR && rc != E_ABORTED && rc != E_TIMEOUT) {
+				nr_of_iter += ws.lastNrOfIter;
+				seed.data = q_path.col(k-1);
+				rc = solve(seed, path[k], q_out, ws, q_min, q_max);
+			}
+		}
+		nr_of_iter += ws.lastNrOfIter;
+		ws.lastNrOfIter = nr_of_iter;
+		q_path.col(k) = q_out.data;
+		if (rc != E_NOERROR)
+			return rc;
+		ws.lastNrOfWaypoints = k+1;
+		if (k == 0) {
+			// the first waypoint may have converged without evaluating the Jacobian;
+			// the forward kinematics of ws.q (= q_out) are the last ones computed.
+			compute_jacobian(ws.q, ws);
+			ws.jac = L.asDiagonal()*ws.jac;
+		}
+	}
+	return E_NOERROR;
+}
+
+void ChainIkSolverPos_LMA::setTimeBudget(double microseconds) {
+	time_budget = microseconds > 0 ? microseconds : 0;
+}
 
+void ChainIkSolverPos_LMA::setSolveMethod(const int& method) {
+	if (method == SOLVE_SVD || method == SOLVE_CHOLESKY)
+		solve_method = method;
 }
 
 const char* ChainIkSolverPos_LMA::strError(const int error) const
     {
         if (E_GRADIENT_JOINTS_TOO_SMALL == error) return "The gradient of E towards the joints is to small";
         else if (E_INCREMENT_JOINTS_TOO_SMALL == error) return "The joint position increments are to small";
+        else if (E_ABORTED == error) return "Aborted: cancelled";
         else return SolverI::strError(error);
     }
 
@@ -34,6 +34,8 @@
 #include "chainiksolver.hpp"
 #include "chain.hpp"
 #include <Eigen/Dense>
+#include <atomic>
+#include <chrono>
 
 namespace KDL
 {
@@ -63,7 +65,7 @@ namespace KDL
  */
 class ChainIkSolverPos_LMA : public KDL::ChainIkSolverPos
 {
-private:
+protected:
 	typedef double ScalarType;
     typedef Eigen::Matrix<ScalarType,Eigen::Dynamic,Eigen::Dynamic> MatrixXq;
     typedef Eigen::Matrix<ScalarType,Eigen::Dynamic,1> VectorXq;
@@ -71,6 +73,12 @@ public:
 
     static const int E_GRADIENT_JOINTS_TOO_SMALL = -100;
     static const int E_INCREMENT_JOINTS_TOO_SMALL = -101;
+    static const int E_ABORTED = -102;
+
+    /// solve the damped least-squares step using the SVD of the Jacobian (default).
+    static const int SOLVE_SVD = 0;
+    /// solve the damped least-squares step using a Cholesky (LDLT) factorization of the normal equations.
+    static const int SOLVE_CHOLESKY = 1;
 
     /**
 	 * \brief constructs an ChainIkSolverPos_LMA solver.
@@ -99,6 +107,14 @@ public:
     		int _maxiter=500,
     		double _eps_joints=1E-15
     );
+    /// Shares the immutable \a chain with other solvers instead of copying it.
+    ChainIkSolverPos_LMA(
+    		const ChainConstPtr& _chain,
+    		const Eigen::Matrix<double,6,1>& _L,
+    		double _eps=1E-5,
+    		int _maxiter=500,
+    		double _eps_joints=1E-15
+    );
 
     /**
      * \brief identical the full constructor for ChainIkSolverPos_LMA, but provides for a default weight matrix.
@@ -111,6 +127,91 @@ public:
     		int _maxiter=500,
     		double _eps_joints=1E-15
     );
+    /// Shares the immutable \a chain with other solvers instead of copying it.
+    ChainIkSolverPos_LMA(
+    		const ChainConstPtr& _chain,
+    		double _eps=1E-5,
+    		int _maxiter=500,
+    		double _eps_joints=1E-15
+    );
+
+    /**
+     * \brief scratch memory and diagnostics of one execution of CartToJnt.
+     *
+     * A workspace holds everything that CartToJnt modifies.  Together with the
+     * const variant of CartToJnt this allows a single solver (and a single copy of the chain)
+     * to be shared by several threads, each of them using its own workspace.
+     * Only the constructor allocates memory.
+     */
+    struct Workspace {
+        /**
+         * \brief allocates a workspace for the given number of joints.
+         */
+        explicit Workspace(std::size_t nj);
+
+        /**
+         * \brief allocates a workspace with the dimensions of the given solver.
+         */
+        explicit Workspace(const ChainIkSolverPos_LMA& solver);
+
+        /**
+         * \brief resizes the workspace, e.g. after the chain of the solver changed.
+         */
+        void resize(std::size_t nj);
+
+        /// number of iterations of the last execution of CartToJnt.
+        int lastNrOfIter;
+        /// value for \f$ E \f$ after the last execution of CartToJnt.
+        double lastDifference;
+        /// (unweighted) translational difference after the last execution of CartToJnt.
+        double lastTransDiff;
+        /// (unweighted) rotational difference after the last execution of CartToJnt.
+        double lastRotDiff;
+        /// singular values of the weighted Jacobian after the last execution of CartToJnt.
+        VectorXq lastSV;
+        /// number of waypoints solved by the last execution of CartToJntPath.
+        std::size_t lastNrOfWaypoints;
+        /// last value for the (weighted) Jacobian.
+        MatrixXq jac;
+        /// gradient of the error criterion.
+        VectorXq grad;
+        /// position of the tip of the robot (head) with respect to the base.
+        KDL::Frame T_base_head;
+
+        // state of compute_fwdpos and compute_jacobian:
+        std::vector<KDL::Frame> T_base_jointroot;
+        std::vector<KDL::Frame> T_base_jointtip;
+                        // need 2 vectors because of the somewhat strange definition of segment.hpp
+                        // you could also recompute jointtip out of jointroot,
+                        // but then you'll need more expensive cos/sin functions.
+
+        // the following are state of CartToJnt that is pre-allocated:
+        VectorXq q;
+        MatrixXq G;     // J^T J (nj<=6) or J J^T (nj>6), for SOLVE_CHOLESKY
+        MatrixXq A;     // G + lambda I
+        VectorXq rhs;
+        VectorXq tmp;
+        Eigen::LDLT<MatrixXq> ldlt;
+        Eigen::JacobiSVD<MatrixXq> svd;
+        VectorXq diffq;
+        VectorXq q_new;
+        VectorXq original_Aii;
+        VectorXq free_joints;   // 1 for joints free to move, 0 for joints held at a bound
+        MatrixXq jac_free;      // weighted Jacobian with the columns of the held joints zeroed
+        KDL::JntArray q_path_seed;  // predicted joint position of the next waypoint
+        KDL::JntArray q_path_out;
+
+        /**
+         * \brief optional cooperative cancellation.
+         *
+         * When not null, CartToJnt checks the flag once per iteration and returns
+         * E_ABORTED with its best configuration so far as soon as it is set.
+         * Used to stop the remaining seeds once one seed of a multi-start search converged.
+         */
+        const std::atomic<bool>* cancel;
+        /// CartToJnt returns E_TIMEOUT once this point in time has passed (default: never).
+        std::chrono::steady_clock::time_point deadline;
+    };
 
     /**
      * \brief computes the inverse position kinematics.
@@ -121,10 +222,73 @@ public:
      * \return E_NOERROR if successful,
      *         E_GRADIENT_JOINTS_TOO_SMALL the gradient of \f$ E \f$ towards the joints is to small,
      *         E_INCREMENT_JOINTS_TOO_SMALL if joint position increments are to small,
-     *         E_MAX_ITER_EXCEEDED if number of iterations is exceeded.
+     *         E_MAX_ITER_EXCEEDED if number of iterations is exceeded,
+     *         E_TIMEOUT if the time budget is exceeded; q_out is then the best configuration so far
+     *         and lastDifference, lastTransDiff and lastRotDiff its residual.
      */
     virtual int CartToJnt(const KDL::JntArray& q_init, const KDL::Frame& T_base_goal, KDL::JntArray& q_out);
 
+    /**
+     * \brief computes the inverse position kinematics using an external workspace.
+     *
+     * This variant does not modify the solver: the diagnostics (lastNrOfIter, lastDifference, ...)
+     * are stored in the workspace and the latest error is not stored.  It can be called
+     * concurrently from several threads as long as each thread uses its own workspace.
+     *
+     * \param ws workspace, allocated for the number of joints of the chain.
+     * \return the same error codes as the non-const variant, E_SIZE_MISMATCH if the
+     *         workspace does not match the chain, E_ABORTED if the workspace was
+     *         cancelled, E_TIMEOUT if its deadline or the time budget passed.
+     */
+    int CartToJnt(const KDL::JntArray& q_init, const KDL::Frame& T_base_goal, KDL::JntArray& q_out, Workspace& ws) const;
+
+    /**
+     * \brief computes the inverse position kinematics along a path of waypoints.
+     *
+     * The first waypoint is solved from q_init as in CartToJnt.  Every next waypoint is
+     * predicted to first order from the previous solution, \f$ \Delta q = J^{+} \Delta x \f$,
+     * using the (weighted) Jacobian left by the iterations of the previous waypoint and the
+     * displacement \f$ \Delta x \f$ between the waypoints.  A few Levenberg-Marquardt
+     * iterations with little damping then correct the prediction.  Only if the corrector
+     * does not converge, the waypoint is solved from the previous solution as in CartToJnt.
+     *
+     * \param q_init initial joint position for the first waypoint.
+     * \param path the waypoints, goal positions expressed with respect to the robot base.
+     * \param q_path matrix of getNrOfJoints() rows and path.size() columns, that receives the
+     *        joint position of every waypoint as a column.  It is not resized.
+     * \return E_NOERROR if all waypoints are reached, E_SIZE_MISMATCH if the sizes do not
+     *         match, otherwise the error of the first waypoint that failed.  Its column holds
+     *         the configuration the solver ended with and the columns after it are not changed;
+     *         lastNrOfWaypoints is the number of waypoints reached.  lastNrOfIter is the total
+     *         number of iterations.
+     */
+    int CartToJntPath(const KDL::JntArray& q_init, const std::vector<KDL::Frame>& path, Eigen::MatrixXd& q_path);
+
+    /**
+     * \brief computes the inverse position kinematics along a path with known velocities.
+     *
+     * Same as above, but the displacement between waypoints k-1 and k is predicted with the
+     * trapezoidal rule \f$ \Delta x = (t_{k-1} + t_k) dt/2 \f$ instead of the difference of the poses
+     * (plus the remaining error at waypoint k-1).
+     *
+     * \param twists velocity of the tip at every waypoint, expressed in the base with the tip
+     *        as reference point (as computed by ChainFkSolverVel).
+     * \param dt time between two waypoints.
+     */
+    int CartToJntPath(const KDL::JntArray& q_init, const std::vector<KDL::Frame>& path,
+                      const std::vector<KDL::Twist>& twists, double dt, Eigen::MatrixXd& q_path);
+
+    /// \copydoc CartToJntPath(const KDL::JntArray&,const std::vector<KDL::Frame>&,Eigen::MatrixXd&)
+    /// This variant uses the external workspace \a ws, as CartToJnt(...,Workspace&) const.
+    int CartToJntPath(const KDL::JntArray& q_init, const std::vector<KDL::Frame>& path, Eigen::MatrixXd& q_path,
+                      Workspace& ws) const;
+
+    /// \copydoc CartToJntPath(const KDL::JntArray&,const std::vector<KDL::Frame>&,const std::vector<KDL::Twist>&,double,Eigen::MatrixXd&)
+    /// This variant uses the external workspace \a ws, as CartToJnt(...,Workspace&) const.
+    int CartToJntPath(const KDL::JntArray& q_init, const std::vector<KDL::Frame>& path,
+                      const std::vector<KDL::Twist>& twists, double dt, Eigen::MatrixXd& q_path,
+                      Workspace& ws) const;
+
     /**
      * \brief destructor.
      */
@@ -156,8 +320,79 @@ public:
     /// @copydoc KDL::SolverI::strError()
     virtual const char* strError(const int error) const;
 
+    /**
+     * \brief selects how the damped least-squares step is solved.
+     *
+     * SOLVE_SVD decomposes the (weighted) Jacobian each time it changes; after a
+     * rejected step only the damping of the singular values is updated.
+     * SOLVE_CHOLESKY factorizes \f$ J^T J + \lambda I \f$ (or \f$ J J^T + \lambda I \f$ for
+     * more than 6 joints), which is several times cheaper.  A rejected step then only
+     * changes the damped diagonal before refactoring the small system.
+     * Other values are ignored.
+     */
+    void setSolveMethod(const int& method);
+
+    /// \brief the current solve method, SOLVE_SVD or SOLVE_CHOLESKY.
+    int getSolveMethod() const { return solve_method; }
+
+    /**
+     * \brief with SOLVE_CHOLESKY, whether lastSV is computed at the end of CartToJnt.
+     *
+     * This costs one SVD per call; by default the singular values are not computed
+     * and lastSV is left unchanged.  SOLVE_SVD always provides them, also when
+     * the seed is already within tolerance or the call is aborted.
+     */
+    void setComputeSingularValues(bool compute) { compute_singular_values = compute; }
+
+    /**
+     * \brief sets a wall-clock budget for one call of CartToJnt in microseconds.
+     *
+     * The clock is read once per iteration, which is negligible compared to the forward
+     * kinematics of the iteration.  As the error never increases during the iterations,
+     * the configuration returned with E_TIMEOUT is the best one found so far.
+     * 0 (default) disables the budget; negative values are treated as 0.
+     */
+    void setTimeBudget(double microseconds);
+
+    /**
+     * \brief the number of joints the solver (and its workspaces) are dimensioned for.
+     */
+    std::size_t getNrOfJoints() const { return nj; }
+
+protected:
+    /**
+     * \brief the Levenberg-Marquardt iterations, optionally restricted to the box [q_min, q_max].
+     *
+     * With bounds, q_init is projected into the box and joints that sit on a bound while the
+     * gradient points outwards are removed from the step (their Jacobian columns are zeroed).
+     * Every step is projected back into the box and evaluated with the gain ratio of the
+     * projected step.  Without bounds (null pointers) this is the plain LMA algorithm.
+     *
+     * \param lambda_init initial damping.
+     * \param iterations maximum number of iterations, 0 for the maximum of the solver.
+     */
+    int solve(const KDL::JntArray& q_init, const KDL::Frame& T_base_goal, KDL::JntArray& q_out, Workspace& ws,
+              const VectorXq* q_min, const VectorXq* q_max, double lambda_init=10, std::size_t iterations=0) const;
+    /**
+     * \brief the box CartToJnt and CartToJntPath are restricted to, null pointers if none.
+     *
+     * Derived classes with joint limits override this.
+     */
+    virtual void getBounds(const VectorXq*& q_min, const VectorXq*& q_max) const;
+    // copies the diagnostics of the internal workspace to the public members below.
+    void copy_diagnostics();
+
+private:
+    void compute_fwdpos(const VectorXq& q, Workspace& ws) const;
+    void compute_jacobian(const VectorXq& q, Workspace& ws) const;
+    int solve_path(const KDL::JntArray& q_init, const std::vector<KDL::Frame>& path,
+                   const std::vector<KDL::Twist>* twists, double dt, Eigen::MatrixXd& q_path, Workspace& ws) const;
+
+protected:
+    const ChainConstPtr chain_ptr;
+    const Chain& chain;
+
 private:
-    const Chain chain;
     std::size_t nj;
     std::size_t ns;
 
@@ -189,6 +424,11 @@ public:
      */
     VectorXq lastSV;
 
+    /**
+     * \brief contains the number of waypoints reached by the last execution of CartToJntPath.
+     */
+    std::size_t lastNrOfWaypoints;
+
     /**
      * \brief for internal use only.
      *
@@ -219,27 +459,13 @@ private:
     double eps;
     double eps_joints;
     Eigen::Matrix<ScalarType,6,1> L;
+    int solve_method;
+    bool compute_singular_values;
+    double time_budget;
 
-
-
-    // state of compute_fwdpos and compute_jacobian:
-    std::vector<KDL::Frame> T_base_jointroot;
-    std::vector<KDL::Frame> T_base_jointtip;
-					// need 2 vectors because of the somewhat strange definition of segment.hpp
-					// you could also recompute jointtip out of jointroot,
-    				// but then you'll need more expensive cos/sin functions.
-
-
-    // the following are state of CartToJnt that is pre-allocated:
-
-    VectorXq q;
-    MatrixXq A;
-    VectorXq tmp;
-    Eigen::LDLT<MatrixXq> ldlt;
-    Eigen::JacobiSVD<MatrixXq> svd;
-    VectorXq diffq;
-    VectorXq q_new;
-    VectorXq original_Aii;
+protected:
+    // workspace used by the non-const CartToJnt, compute_fwdpos and compute_jacobian:
+    Workspace ws_;
 };
 
 
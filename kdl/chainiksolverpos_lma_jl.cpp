@@ -0,0 +1,106 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainiksolverpos_lma_jl.hpp"
+
+#include <limits>
+
+namespace KDL {
+
+ChainIkSolverPos_LMA_JL::ChainIkSolverPos_LMA_JL(
+        const KDL::Chain& _chain,
+        const Eigen::Matrix<double,6,1>& _L,
+        double _eps,
+        int _maxiter,
+        double _eps_joints
+) :
+    ChainIkSolverPos_LMA_JL(std::make_shared<const Chain>(_chain), _L, _eps, _maxiter, _eps_joints)
+{}
+
+ChainIkSolverPos_LMA_JL::ChainIkSolverPos_LMA_JL(
+        const ChainConstPtr& _chain,
+        const Eigen::Matrix<double,6,1>& _L,
+        double _eps,
+        int _maxiter,
+        double _eps_joints
+) :
+    ChainIkSolverPos_LMA(_chain, _L, _eps, _maxiter, _eps_joints)
+{
+    readJointLimits();
+}
+
+ChainIkSolverPos_LMA_JL::ChainIkSolverPos_LMA_JL(
+        const KDL::Chain& _chain,
+        double _eps,
+        int _maxiter,
+        double _eps_joints
+) :
+    ChainIkSolverPos_LMA_JL(std::make_shared<const Chain>(_chain), _eps, _maxiter, _eps_joints)
+{}
+
+ChainIkSolverPos_LMA_JL::ChainIkSolverPos_LMA_JL(
+        const ChainConstPtr& _chain,
+        double _eps,
+        int _maxiter,
+        double _eps_joints
+) :
+    ChainIkSolverPos_LMA(_chain, _eps, _maxiter, _eps_joints)
+{
+    readJointLimits();
+}
+
+ChainIkSolverPos_LMA_JL::~ChainIkSolverPos_LMA_JL() {}
+
+void ChainIkSolverPos_LMA_JL::readJointLimits() {
+    const double inf = std::numeric_limits<double>::infinity();
+    q_min.resize(getNrOfJoints());
+    q_max.resize(getNrOfJoints());
+    const std::vector<Joint>& joints = chain.getJoints();
+    for (std::size_t i=0, j=0; i<joints.size(); ++i) {
+        if (joints[i].getType() == Joint::Fixed)
+            continue;
+        const double lower = joints[i].getLowerPositionLimit();
+        const double upper = joints[i].getUpperPositionLimit();
+        q_min(j) = lower < upper ? lower : -inf;
+        q_max(j) = lower < upper ? upper : inf;
+        ++j;
+    }
+    limited = (q_min.array().isFinite() || q_max.array().isFinite()).any();
+}
+
+void ChainIkSolverPos_LMA_JL::updateInternalDataStructures() {
+    ChainIkSolverPos_LMA::updateInternalDataStructures();
+    readJointLimits();
+}
+
+int ChainIkSolverPos_LMA_JL::setJointLimits(const JntArray& q_min_in, const JntArray& q_max_in) {
+    if (q_min_in.rows() != getNrOfJoints() || q_max_in.rows() != getNrOfJoints())
+        return (error = E_SIZE_MISMATCH);
+    if ((q_min_in.data.array() > q_max_in.data.array()).any())
+        return (error = E_OUT_OF_RANGE);
+    q_min = q_min_in.data.cast<ScalarType>();
+    q_max = q_max_in.data.cast<ScalarType>();
+    limited = (q_min.array().isFinite() || q_max.array().isFinite()).any();
+    return (error = E_NOERROR);
+}
+
+void ChainIkSolverPos_LMA_JL::getBounds(const VectorXq*& q_min_out, const VectorXq*& q_max_out) const {
+    // without any finite limit this is the plain LMA algorithm
+    q_min_out = limited ? &q_min : nullptr;
+    q_max_out = limited ? &q_max : nullptr;
+}
+
+} // namespace KDL
@@ -0,0 +1,106 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_CHAINIKSOLVERPOS_LMA_JL_HPP
+#define KDL_CHAINIKSOLVERPOS_LMA_JL_HPP
+
+#include "chainiksolverpos_lma.hpp"
+
+namespace KDL
+{
+
+/**
+ * \brief Levenberg-Marquardt inverse position kinematics within joint limits.
+ *
+ * Box-constrained variant of ChainIkSolverPos_LMA.  Instead of clamping the
+ * result of an unconstrained step (as ChainIkSolverPos_NR_JL does), the bounds
+ * are handled inside the step computation: joints that sit on a bound while the
+ * gradient pushes them outwards are held fixed for the step, the remaining
+ * joints are solved for, and the step is projected onto the box.  The damping
+ * is adapted with the gain ratio of the projected step.
+ *
+ * The limits are taken from Joint::getLowerPositionLimit() and
+ * Joint::getUpperPositionLimit(); joints with lower >= upper are unlimited.
+ * They can be replaced with setJointLimits().  All variants of CartToJnt and
+ * CartToJntPath respect the limits; q_init is projected into them first.  The error
+ * codes are those of ChainIkSolverPos_LMA, E_GRADIENT_JOINTS_TOO_SMALL also signals
+ * a minimum of the error on the boundary of the limits.
+ *
+ * \ingroup KinematicFamily
+ */
+class ChainIkSolverPos_LMA_JL : public ChainIkSolverPos_LMA
+{
+public:
+    /// \copydoc ChainIkSolverPos_LMA::ChainIkSolverPos_LMA(const KDL::Chain&,const Eigen::Matrix<double,6,1>&,double,int,double)
+    ChainIkSolverPos_LMA_JL(
+            const KDL::Chain& _chain,
+            const Eigen::Matrix<double,6,1>& _L,
+            double _eps=1E-5,
+            int _maxiter=500,
+            double _eps_joints=1E-15
+    );
+    /// Shares the immutable \a chain with other solvers instead of copying it.
+    ChainIkSolverPos_LMA_JL(
+            const ChainConstPtr& _chain,
+            const Eigen::Matrix<double,6,1>& _L,
+            double _eps=1E-5,
+            int _maxiter=500,
+            double _eps_joints=1E-15
+    );
+    /// Same as above, with the default weights of ChainIkSolverPos_LMA.
+    explicit ChainIkSolverPos_LMA_JL(
+            const KDL::Chain& _chain,
+            double _eps=1E-5,
+            int _maxiter=500,
+            double _eps_joints=1E-15
+    );
+    /// Shares the immutable \a chain with other solvers instead of copying it.
+    explicit ChainIkSolverPos_LMA_JL(
+            const ChainConstPtr& _chain,
+            double _eps=1E-5,
+            int _maxiter=500,
+            double _eps_joints=1E-15
+    );
+
+    virtual ~ChainIkSolverPos_LMA_JL();
+
+    /**
+     * \brief replaces the joint limits.
+     *
+     * \return E_SIZE_MISMATCH if the sizes do not match the number of joints,
+     *         E_OUT_OF_RANGE if a lower limit is above its upper limit.
+     */
+    int setJointLimits(const JntArray& q_min, const JntArray& q_max);
+
+    /// @copydoc KDL::SolverI::updateInternalDataStructures
+    void updateInternalDataStructures();
+
+protected:
+    /// the joint limits, unless no joint is limited.
+    virtual void getBounds(const VectorXq*& q_min, const VectorXq*& q_max) const;
+
+private:
+    // reads the limits of the joints of the chain
+    void readJointLimits();
+
+    VectorXq q_min;
+    VectorXq q_max;
+    bool limited;
+};
+
+} // namespace KDL
+
+#endif
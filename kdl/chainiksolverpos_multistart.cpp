@@ -0,0 +1,245 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainiksolverpos_multistart.hpp"
+
+#include <chrono>
+#include <limits>
+
+namespace KDL
+{
+    const int ChainIkSolverPos_MultiStart::FIRST_SOLUTION;
+    const int ChainIkSolverPos_MultiStart::NEAREST_SOLUTION;
+
+    ChainIkSolverPos_MultiStart::ChainIkSolverPos_MultiStart(const ChainConstPtr& _chain, const Eigen::Matrix<double,6,1>& _L,
+                                                             std::size_t _nr_of_seeds, std::size_t _nr_of_threads,
+                                                             double _eps, int _maxiter, double _eps_joints):
+        chain_ptr(_chain),
+        chain(*chain_ptr),
+        nj(chain.getNrOfJoints()),
+        lma(chain_ptr, _L, _eps, _maxiter, _eps_joints),
+        pool(_nr_of_threads),
+        workspaces(pool.size(), ChainIkSolverPos_LMA::Workspace(nj)),
+        selection(FIRST_SOLUTION),
+        nr_of_seeds(_nr_of_seeds > 0 ? _nr_of_seeds : 1),
+        seed_min(nj),
+        seed_max(nj),
+        max_time(0),
+        cancel(false),
+        winner(-1),
+        last_seed(-1),
+        last_difference(0),
+        last_nr_of_solutions(0)
+    {
+        initSeedLimits();
+        resizeSeeds();
+    }
+
+    ChainIkSolverPos_MultiStart::ChainIkSolverPos_MultiStart(const ChainConstPtr& _chain,
+                                                             std::size_t _nr_of_seeds, std::size_t _nr_of_threads,
+                                                             double _eps, int _maxiter, double _eps_joints):
+        ChainIkSolverPos_MultiStart(_chain, (Eigen::Matrix<double,6,1>() << 1, 1, 1, 0.01, 0.01, 0.01).finished(),
+                                    _nr_of_seeds, _nr_of_threads, _eps, _maxiter, _eps_joints)
+    {
+    }
+
+    ChainIkSolverPos_MultiStart::ChainIkSolverPos_MultiStart(const Chain& _chain, const Eigen::Matrix<double,6,1>& _L,
+                                                             std::size_t _nr_of_seeds, std::size_t _nr_of_threads,
+                                                             double _eps, int _maxiter, double _eps_joints):
+        ChainIkSolverPos_MultiStart(std::make_shared<const Chain>(_chain), _L, _nr_of_seeds, _nr_of_threads, _eps, _maxiter, _eps_joints)
+    {
+    }
+
+    ChainIkSolverPos_MultiStart::ChainIkSolverPos_MultiStart(const Chain& _chain,
+                                                             std::size_t _nr_of_seeds, std::size_t _nr_of_threads,
+                                                             double _eps, int _maxiter, double _eps_joints):
+        ChainIkSolverPos_MultiStart(std::make_shared<const Chain>(_chain), _nr_of_seeds, _nr_of_threads, _eps, _maxiter, _eps_joints)
+    {
+    }
+
+    ChainIkSolverPos_MultiStart::~ChainIkSolverPos_MultiStart()
+    {
+    }
+
+    void ChainIkSolverPos_MultiStart::initSeedLimits()
+    {
+        seed_min.resize(nj);
+        seed_max.resize(nj);
+        for (std::size_t i = 0, j = 0; i < chain.getNrOfSegments(); ++i) {
+            const Joint& joint = chain.getSegment(i).getJoint();
+            if (joint.getType() == Joint::Fixed)
+                continue;
+            if (joint.getLowerPositionLimit() < joint.getUpperPositionLimit()) {
+                seed_min(j) = joint.getLowerPositionLimit();
+                seed_max(j) = joint.getUpperPositionLimit();
+            } else {
+                seed_min(j) = -PI;
+                seed_max(j) = PI;
+            }
+            ++j;
+        }
+    }
+
+    void ChainIkSolverPos_MultiStart::resizeSeeds()
+    {
+        seeds.assign(nr_of_seeds, JntArray(nj));
+        solutions.assign(nr_of_seeds, JntArray(nj));
+        codes.assign(nr_of_seeds, E_NOERROR);
+        differences.assign(nr_of_seeds, 0.0);
+    }
+
+    void ChainIkSolverPos_MultiStart::updateInternalDataStructures()
+    {
+        nj = chain.getNrOfJoints();
+        lma.updateInternalDataStructures();
+        for (std::size_t i = 0; i < workspaces.size(); ++i)
+            workspaces[i].resize(nj);
+        user_seeds.clear();
+        initSeedLimits();
+        resizeSeeds();
+    }
+
+    void ChainIkSolverPos_MultiStart::setSelection(const int& _selection)
+    {
+        if (_selection == FIRST_SOLUTION || _selection == NEAREST_SOLUTION)
+            selection = _selection;
+    }
+
+    void ChainIkSolverPos_MultiStart::setNrOfSeeds(std::size_t _nr_of_seeds)
+    {
+        nr_of_seeds = _nr_of_seeds > 0 ? _nr_of_seeds : 1;
+        resizeSeeds();
+    }
+
+    int ChainIkSolverPos_MultiStart::setSeeds(const std::vector<JntArray>& _seeds)
+    {
+        if (_seeds.size() >= nr_of_seeds)
+            return (error = E_OUT_OF_RANGE);
+        for (std::size_t i = 0; i < _seeds.size(); ++i)
+            if (_seeds[i].rows() != nj)
+                return (error = E_SIZE_MISMATCH);
+        user_seeds = _seeds;
+        return (error = E_NOERROR);
+    }
+
+    int ChainIkSolverPos_MultiStart::setSeedLimits(const JntArray& q_min, const JntArray& q_max)
+    {
+        if (q_min.rows() != nj || q_max.rows() != nj)
+            return (error = E_SIZE_MISMATCH);
+        seed_min = q_min;
+        seed_max = q_max;
+        return (error = E_NOERROR);
+    }
+
+    void ChainIkSolverPos_MultiStart::setRandomSeed(unsigned int seed)
+    {
+        rng.seed(seed);
+    }
+
+    void ChainIkSolverPos_MultiStart::setMaxTime(double seconds)
+    {
+        max_time = seconds > 0 ? seconds : 0;
+    }
+
+    int ChainIkSolverPos_MultiStart::CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        if (nj != chain.getNrOfJoints() || nj != lma.getNrOfJoints())
+            return (error = E_NOT_UP_TO_DATE);
+
+        if (q_init.rows() != nj || q_out.rows() != nj)
+            return (error = E_SIZE_MISMATCH);
+
+        // seeds are drawn before the parallel section, the generator is not thread-safe.
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        seeds[0] = q_init;
+        for (std::size_t k = 1; k < nr_of_seeds; ++k) {
+            if (k - 1 < user_seeds.size()) {
+                seeds[k] = user_seeds[k - 1];
+                continue;
+            }
+            for (std::size_t j = 0; j < nj; ++j)
+                seeds[k](j) = seed_min(j) + uniform(rng) * (seed_max(j) - seed_min(j));
+        }
+
+        const std::chrono::steady_clock::time_point deadline = max_time > 0 ?
+            std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(max_time)) :
+            std::chrono::steady_clock::time_point::max();
+        for (std::size_t t = 0; t < workspaces.size(); ++t) {
+            workspaces[t].cancel = selection == FIRST_SOLUTION ? &cancel : nullptr;
+            workspaces[t].deadline = deadline;
+        }
+        cancel.store(false);
+        winner.store(-1);
+
+        pool.parallel_for(nr_of_seeds, [&](std::size_t k, std::size_t t) {
+            if (cancel.load(std::memory_order_relaxed) || std::chrono::steady_clock::now() > deadline) {
+                codes[k] = cancel.load(std::memory_order_relaxed) ? ChainIkSolverPos_LMA::E_ABORTED : E_TIMEOUT;
+                differences[k] = std::numeric_limits<double>::infinity();
+                return;
+            }
+            ChainIkSolverPos_LMA::Workspace& ws = workspaces[t];
+            codes[k] = lma.CartToJnt(seeds[k], p_in, solutions[k], ws);
+            differences[k] = ws.lastDifference;
+            if (codes[k] == E_NOERROR && selection == FIRST_SOLUTION) {
+                int none = -1;
+                if (winner.compare_exchange_strong(none, (int)k))
+                    cancel.store(true, std::memory_order_relaxed);
+            }
+        });
+
+        last_seed = -1;
+        last_nr_of_solutions = 0;
+        double best_distance = std::numeric_limits<double>::infinity();
+        double best_difference = std::numeric_limits<double>::infinity();
+        int best_failure = -1;
+        for (std::size_t k = 0; k < nr_of_seeds; ++k) {
+            if (codes[k] == E_NOERROR) {
+                ++last_nr_of_solutions;
+                double distance = (solutions[k].data - q_init.data).norm();
+                if (selection == NEAREST_SOLUTION && distance < best_distance) {
+                    best_distance = distance;
+                    last_seed = (int)k;
+                }
+            } else if (differences[k] < best_difference) {
+                best_difference = differences[k];
+                best_failure = (int)k;
+            }
+        }
+        if (selection == FIRST_SOLUTION)
+            last_seed = winner.load();
+
+        if (last_seed >= 0) {
+            q_out = solutions[last_seed];
+            last_difference = differences[last_seed];
+            return (error = E_NOERROR);
+        }
+        if (best_failure < 0) {
+            q_out = q_init;
+            last_difference = 0;
+            return (error = E_TIMEOUT);
+        }
+        last_seed = best_failure;
+        q_out = solutions[last_seed];
+        last_difference = differences[last_seed];
+        return (error = codes[last_seed]);
+    }
+
+    const char* ChainIkSolverPos_MultiStart::strError(const int error) const
+    {
+        return lma.strError(error);
+    }
+}
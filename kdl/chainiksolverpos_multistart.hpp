@@ -0,0 +1,182 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDLCHAINIKSOLVERPOS_MULTISTART_HPP
+#define KDLCHAINIKSOLVERPOS_MULTISTART_HPP
+
+#include "chainiksolverpos_lma.hpp"
+#include "utilities/thread_pool.hpp"
+
+#include <atomic>
+#include <random>
+#include <vector>
+
+namespace KDL {
+
+    /**
+     * \brief Multi-start inverse position kinematics on top of ChainIkSolverPos_LMA.
+     *
+     * A single Levenberg-Marquardt run can get stuck in a local minimum.  This
+     * solver starts the LMA solver from several seeds concurrently on an
+     * internal thread pool.  All seeds share one LMA solver (and one chain);
+     * every thread has its own ChainIkSolverPos_LMA::Workspace.
+     *
+     * The first seed is always q_init, followed by the seeds given with
+     * setSeeds() and by random configurations sampled within the seed limits.
+     *
+     * Two selection modes are available:
+     *   - FIRST_SOLUTION: the first seed that converges within eps wins and the
+     *     remaining seeds are cancelled cooperatively;
+     *   - NEAREST_SOLUTION: all seeds are run, the converged solution closest
+     *     to q_init (euclidean norm in joint space) is returned.
+     *
+     * Memory is only allocated by the constructor and the setters, CartToJnt
+     * itself does not allocate.
+     *
+     * Only LMA runs the seeds: it is the single-seed solver that can be
+     * cancelled and bounded by a deadline from another thread.  For joint
+     * limits with ChainIkSolverPos_NR_JL, run its const CartToJnt with one
+     * ChainIkSolverPos_NR_JL::Workspace per thread instead.
+     */
+    class ChainIkSolverPos_MultiStart : public ChainIkSolverPos
+    {
+    public:
+        static const int FIRST_SOLUTION = 0;
+        static const int NEAREST_SOLUTION = 1;
+
+        /**
+         * Constructor of the solver.
+         *
+         * @param chain the chain to calculate the inverse position for
+         * @param L weights of the task space error, see ChainIkSolverPos_LMA
+         * @param nr_of_seeds number of seeds tried for every call (at least 1)
+         * @param nr_of_threads number of threads, including the calling thread.
+         *        0 selects the number of hardware threads.
+         * @param eps, maxiter, eps_joints parameters of the LMA solver
+         */
+        ChainIkSolverPos_MultiStart(const ChainConstPtr& chain, const Eigen::Matrix<double,6,1>& L,
+                                    std::size_t nr_of_seeds=16, std::size_t nr_of_threads=0,
+                                    double eps=1E-5, int maxiter=500, double eps_joints=1E-15);
+        /// Same as above, but with the default weights of ChainIkSolverPos_LMA.
+        explicit ChainIkSolverPos_MultiStart(const ChainConstPtr& chain,
+                                    std::size_t nr_of_seeds=16, std::size_t nr_of_threads=0,
+                                    double eps=1E-5, int maxiter=500, double eps_joints=1E-15);
+        /// Constructor making an internal copy of \a chain.
+        ChainIkSolverPos_MultiStart(const Chain& chain, const Eigen::Matrix<double,6,1>& L,
+                                    std::size_t nr_of_seeds=16, std::size_t nr_of_threads=0,
+                                    double eps=1E-5, int maxiter=500, double eps_joints=1E-15);
+        /// Constructor making an internal copy of \a chain.
+        explicit ChainIkSolverPos_MultiStart(const Chain& chain,
+                                    std::size_t nr_of_seeds=16, std::size_t nr_of_threads=0,
+                                    double eps=1E-5, int maxiter=500, double eps_joints=1E-15);
+        ~ChainIkSolverPos_MultiStart();
+
+        /**
+         * Calculates the joint positions for the Cartesian pose p_in.
+         *
+         * @param q_init first seed, and the reference for NEAREST_SOLUTION
+         * @param p_in the desired pose of the tip with respect to the base
+         * @param q_out the solution, or the configuration with the smallest
+         *        remaining error when no seed converged
+         * @return E_NOERROR if a seed converged, otherwise the error code of the
+         *         attempt with the smallest remaining error (E_TIMEOUT if the
+         *         deadline passed while it was running, or before any seed started).
+         */
+        virtual int CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out);
+
+        /// Selects FIRST_SOLUTION or NEAREST_SOLUTION, other values are ignored.
+        void setSelection(const int& selection);
+
+        /**
+         * Sets the number of seeds tried for every call (at least 1).  User
+         * seeds beyond the first nr_of_seeds-1 are then not tried.
+         */
+        void setNrOfSeeds(std::size_t nr_of_seeds);
+
+        /**
+         * Sets user-defined seeds, tried after q_init and before the random seeds.
+         * @return E_SIZE_MISMATCH if a seed does not match the number of joints,
+         * E_OUT_OF_RANGE if there are more than nr_of_seeds-1 seeds.  The
+         * seeds are not changed on error.
+         */
+        int setSeeds(const std::vector<JntArray>& seeds);
+
+        /**
+         * Sets the box from which the random seeds are sampled.  By default the
+         * position limits of the joints are used; joints without limits
+         * (lower >= upper) are sampled in [-pi, pi].
+         * @return E_SIZE_MISMATCH if the sizes do not match the number of joints.
+         */
+        int setSeedLimits(const JntArray& q_min, const JntArray& q_max);
+
+        /// Seeds the generator of the random seeds, for reproducible results.
+        void setRandomSeed(unsigned int seed);
+
+        /**
+         * Sets a wall-clock budget for one call of CartToJnt in seconds.
+         * Seeds still running when it expires return their best configuration so
+         * far with E_TIMEOUT. 0 disables the deadline.
+         */
+        void setMaxTime(double seconds);
+
+        /// Index of the seed that produced the last q_out (0 is q_init), -1 if none ran.
+        int getLastSeed() const { return last_seed; }
+        /// Weighted task space error of the last q_out.
+        double getLastDifference() const { return last_difference; }
+        /// Number of seeds that converged during the last call.
+        std::size_t getLastNrOfSolutions() const { return last_nr_of_solutions; }
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+        /// @copydoc KDL::SolverI::strError()
+        virtual const char* strError(const int error) const;
+
+    private:
+        void initSeedLimits();
+        void resizeSeeds();
+
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
+        std::size_t nj;
+        ChainIkSolverPos_LMA lma;
+        ThreadPool pool;
+        std::vector<ChainIkSolverPos_LMA::Workspace> workspaces;
+
+        int selection;
+        std::size_t nr_of_seeds;
+        std::vector<JntArray> user_seeds;
+        JntArray seed_min;
+        JntArray seed_max;
+        std::mt19937 rng;
+        double max_time;
+
+        // per seed state of one CartToJnt call:
+        std::vector<JntArray> seeds;
+        std::vector<JntArray> solutions;
+        std::vector<int> codes;
+        std::vector<double> differences;
+        std::atomic<bool> cancel;
+        std::atomic<int> winner;
+
+        int last_seed;
+        double last_difference;
+        std::size_t last_nr_of_solutions;
+    };
+
+}
+
+#endif
@@ -21,50 +21,110 @@
 
 #include "chainiksolverpos_nr.hpp"
 
+#include <chrono>
+#include <cmath>
+#include <limits>
+
 namespace KDL
 {
     ChainIkSolverPos_NR::ChainIkSolverPos_NR(const Chain& _chain,ChainFkSolverPos& _fksolver,ChainIkSolverVel& _iksolver,
                                              std::size_t _maxiter, double _eps):
-        chain(_chain),nj (chain.getNrOfJoints()),
-        iksolver(_iksolver),fksolver(_fksolver),
-        delta_q(_chain.getNrOfJoints()),
-        maxiter(_maxiter),eps(_eps)
+        ChainIkSolverPos_NR(std::make_shared<const Chain>(_chain), _fksolver, _iksolver, _maxiter, _eps)
+    {
+    }
+
+    ChainIkSolverPos_NR::ChainIkSolverPos_NR(const ChainConstPtr& _chain,ChainFkSolverPos& _fksolver,ChainIkSolverVel& _iksolver,
+                                             std::size_t _maxiter, double _eps):
+        chain_ptr(_chain),
+        chain(*chain_ptr),nj (chain.getNrOfJoints()),
+        ws_(nj,_fksolver,_iksolver),
+        maxiter(_maxiter),eps(_eps),time_budget(0),
+        last_difference(0),last_nr_of_iter(0)
     {
     }
 
+    ChainIkSolverPos_NR::Workspace::Workspace(std::size_t nj, ChainFkSolverPos& _fksolver, ChainIkSolverVel& _iksolver):
+        fksolver(_fksolver),iksolver(_iksolver),
+        delta_q(nj),q_best(nj),last_difference(0),last_nr_of_iter(0)
+    {
+    }
+
+    void ChainIkSolverPos_NR::Workspace::resize(std::size_t nj)
+    {
+        delta_q.resize(nj);
+        q_best.resize(nj);
+    }
+
     void ChainIkSolverPos_NR::updateInternalDataStructures() {
         nj = chain.getNrOfJoints();
-        iksolver.updateInternalDataStructures();
-        fksolver.updateInternalDataStructures();
-        delta_q.resize(nj);
+        ws_.iksolver.updateInternalDataStructures();
+        ws_.fksolver.updateInternalDataStructures();
+        ws_.resize(nj);
+    }
+
+    void ChainIkSolverPos_NR::setTimeBudget(double microseconds)
+    {
+        time_budget = microseconds > 0 ? microseconds : 0;
     }
 
     int ChainIkSolverPos_NR::CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out)
     {
+        KDL_SOLVER_TELEMETRY_SCOPE_ITER(last_nr_of_iter);
+        error = CartToJnt(q_init, p_in, q_out, ws_);
+        last_difference = ws_.last_difference;
+        last_nr_of_iter = ws_.last_nr_of_iter;
+        return error;
+    }
+
+    int ChainIkSolverPos_NR::CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out, Workspace& ws) const
+    {
+        ws.last_nr_of_iter = 0;
+
         if (nj != chain.getNrOfJoints())
-            return (error = E_NOT_UP_TO_DATE);
+            return E_NOT_UP_TO_DATE;
 
-        if(q_init.rows() != nj || q_out.rows() != nj)
-            return (error = E_SIZE_MISMATCH);
+        if(q_init.rows() != nj || q_out.rows() != nj || ws.delta_q.rows() != nj)
+            return E_SIZE_MISMATCH;
 
         q_out = q_init;
 
+        const bool timed = time_budget > 0;
+        std::chrono::steady_clock::time_point deadline;
+        if (timed)
+            deadline = std::chrono::steady_clock::now() +
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::micro>(time_budget));
+        double best_difference = std::numeric_limits<double>::infinity();
+
         std::size_t i;
         for(i=0;i<maxiter;i++){
-            if (E_NOERROR > fksolver.JntToCart(q_out,f) )
-                return (error = E_FKSOLVERPOS_FAILED);
-            delta_twist = diff(f,p_in);
-            const int rc = iksolver.CartToJnt(q_out,delta_twist,delta_q);
+            if (E_NOERROR > ws.fksolver.JntToCart(q_out,ws.f) )
+                return E_FKSOLVERPOS_FAILED;
+            ws.delta_twist = diff(ws.f,p_in);
+            ws.last_difference = std::hypot(ws.delta_twist.vel.Norm(), ws.delta_twist.rot.Norm());
+            if (timed) {
+                // Newton-Raphson does not decrease the residual monotonically
+                if (ws.last_difference < best_difference) {
+                    best_difference = ws.last_difference;
+                    ws.q_best = q_out;
+                }
+                if (std::chrono::steady_clock::now() > deadline) {
+                    q_out = ws.q_best;
+                    ws.last_difference = best_difference;
+                    return E_TIMEOUT;
+                }
+            }
+            const int rc = ws.iksolver.CartToJnt(q_out,ws.delta_twist,ws.delta_q);
             if (E_NOERROR > rc)
-                return (error = E_IKSOLVER_FAILED);
+                return E_IKSOLVER_FAILED;
             // we chose to continue if the child solver returned a positive
             // "error", which may simply indicate a degraded solution
-            Add(q_out,delta_q,q_out);
-            if(Equal(delta_twist,Twist::Zero(),eps))
+            Add(q_out,ws.delta_q,q_out);
+            ws.last_nr_of_iter = i+1;
+            if(Equal(ws.delta_twist,Twist::Zero(),eps))
                 // converged, but possibly with a degraded solution
                 return (rc > E_NOERROR ? E_DEGRADED : E_NOERROR);
         }
-        return (error = E_MAX_ITERATIONS_EXCEEDED);        // failed to converge
+        return E_MAX_ITERATIONS_EXCEEDED;        // failed to converge
     }
 
     ChainIkSolverPos_NR::~ChainIkSolverPos_NR()
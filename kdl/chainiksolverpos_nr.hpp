@@ -41,6 +41,31 @@ namespace KDL {
         static const int E_IKSOLVER_FAILED = -100; //! Child IK solver vel failed
         static const int E_FKSOLVERPOS_FAILED = -101; //! Child FK solver failed
 
+        /**
+         * \brief Everything that CartToJnt modifies.
+         *
+         * With the const variant of CartToJnt a single solver can be
+         * shared by several threads, each of them using its own workspace.
+         * The child solvers keep state of their own, so a workspace refers
+         * to its own forward position and inverse velocity solvers, e.g.
+         * constructed for the same ChainConstPtr.
+         */
+        struct Workspace {
+            Workspace(std::size_t nj, ChainFkSolverPos& fksolver, ChainIkSolverVel& iksolver);
+            void resize(std::size_t nj);
+
+            ChainFkSolverPos& fksolver;
+            ChainIkSolverVel& iksolver;
+            JntArray delta_q;
+            Frame f;
+            Twist delta_twist;
+            JntArray q_best;
+            /// residual of the last call, see getLastDifference()
+            double last_difference;
+            /// number of iterations of the last call
+            std::size_t last_nr_of_iter;
+        };
+
         /**
          * Constructor of the solver, it needs the chain, a forward
          * position kinematics solver and an inverse velocity
@@ -58,6 +83,9 @@ namespace KDL {
          */
         ChainIkSolverPos_NR(const Chain& chain,ChainFkSolverPos& fksolver,ChainIkSolverVel& iksolver,
                             std::size_t maxiter=100,double eps=1e-6);
+        /// Shares the immutable \a chain with other solvers instead of copying it.
+        ChainIkSolverPos_NR(const ChainConstPtr& chain,ChainFkSolverPos& fksolver,ChainIkSolverVel& iksolver,
+                            std::size_t maxiter=100,double eps=1e-6);
         ~ChainIkSolverPos_NR();
 
         /**
@@ -70,26 +98,53 @@ namespace KDL {
          *  degraded in quality (e.g. pseudo-inverse in iksolver is singular)
          *  E_IKSOLVER_FAILED=velocity solver failed
          *  E_NO_CONVERGE=solution did not converge (e.g. large displacement, low iterations)
+         *  E_TIMEOUT=the time budget was exceeded, q_out is the best configuration so far
          */
         virtual int CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out);
 
+        /**
+         * Same as above, with the external workspace \a ws instead of the
+         * internal one.  Neither the error nor the diagnostics of the
+         * solver are updated, they are left in \a ws.
+         */
+        int CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out, Workspace& ws) const;
+
+        /**
+         * Sets a wall-clock budget for one call of CartToJnt in microseconds.
+         * The clock is read once per iteration.  When the budget is exceeded,
+         * CartToJnt returns E_TIMEOUT with the configuration with the smallest
+         * residual found so far.  0 (default) disables the budget; negative
+         * values are treated as 0.
+         */
+        void setTimeBudget(double microseconds);
+
+        /**
+         * Norm of the twist from the pose of the last evaluated configuration
+         * to the goal.  After E_TIMEOUT it is the residual of the returned q_out.
+         */
+        double getLastDifference() const { return last_difference; }
+
+        /// Number of iterations of the last call.
+        std::size_t getLastNrOfIter() const { return last_nr_of_iter; }
+
         /// @copydoc KDL::SolverI::strError()
         virtual const char* strError(const int error) const;
 
         /// @copydoc KDL::SolverI::updateInternalDataStructures
         virtual void updateInternalDataStructures();
     private:
-        const Chain chain;
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
 
         std::size_t nj;
-        ChainIkSolverVel& iksolver;
-        ChainFkSolverPos& fksolver;
-        JntArray delta_q;
-        Frame f;
-        Twist delta_twist;
+        Workspace ws_;
 
         std::size_t maxiter;
         double eps;
+        double time_budget;
+
+        double last_difference;
+        std::size_t last_nr_of_iter;
     };
 
 }
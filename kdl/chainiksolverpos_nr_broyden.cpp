@@ -0,0 +1,207 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainiksolverpos_nr_broyden.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace KDL
+{
+    namespace
+    {
+        // singular values below this are not inverted (truncated pseudo-inverse)
+        const double SVD_EPS = 1e-5;
+        // an updated pseudo-inverse has stalled when a step does not reduce the residual to this fraction
+        const double STALL_RATIO = 0.5;
+
+        void twistToVector(const Twist& t, Eigen::VectorXd& v)
+        {
+            for (int i = 0; i < 3; ++i) {
+                v(i) = t.vel(i);
+                v(3 + i) = t.rot(i);
+            }
+        }
+    }
+
+    ChainIkSolverPos_NR_Broyden::ChainIkSolverPos_NR_Broyden(const Chain& _chain, ChainFkSolverPos& _fksolver,
+                                                             std::size_t _maxiter, double _eps,
+                                                             double _broyden_threshold, std::size_t _refresh_interval):
+        ChainIkSolverPos_NR_Broyden(std::make_shared<const Chain>(_chain), _fksolver, _maxiter, _eps,
+                                    _broyden_threshold, _refresh_interval)
+    {
+    }
+
+    ChainIkSolverPos_NR_Broyden::ChainIkSolverPos_NR_Broyden(const ChainConstPtr& _chain, ChainFkSolverPos& _fksolver,
+                                                             std::size_t _maxiter, double _eps,
+                                                             double _broyden_threshold, std::size_t _refresh_interval):
+        chain_ptr(_chain),
+        chain(*chain_ptr), nj(chain.getNrOfJoints()),
+        fksolver(_fksolver), jnt2jac(chain_ptr),
+        jac(nj), svd(6, nj, Eigen::ComputeThinU | Eigen::ComputeThinV),
+        jac_pinv(nj, 6), V_S(nj, nj < 6 ? nj : 6),
+        delta_q(nj), delta_x(6), correction(nj),
+        q_prev(nj), q_best(nj),
+        maxiter(_maxiter), eps(_eps),
+        broyden_threshold(_broyden_threshold), refresh_interval(_refresh_interval),
+        time_budget(0),
+        last_difference(0), last_nr_of_iter(0),
+        last_nr_of_jacobians(0), last_nr_of_updates(0)
+    {
+    }
+
+    ChainIkSolverPos_NR_Broyden::~ChainIkSolverPos_NR_Broyden()
+    {
+    }
+
+    void ChainIkSolverPos_NR_Broyden::updateInternalDataStructures()
+    {
+        nj = chain.getNrOfJoints();
+        fksolver.updateInternalDataStructures();
+        jnt2jac.updateInternalDataStructures();
+        jac.resize(nj);
+        svd = Eigen::JacobiSVD<Eigen::MatrixXd>(6, nj, Eigen::ComputeThinU | Eigen::ComputeThinV);
+        jac_pinv.resize(nj, 6);
+        V_S.resize(nj, nj < 6 ? nj : 6);
+        delta_q.resize(nj);
+        correction.resize(nj);
+        q_prev.resize(nj);
+        q_best.resize(nj);
+    }
+
+    void ChainIkSolverPos_NR_Broyden::setTimeBudget(double microseconds)
+    {
+        time_budget = microseconds > 0 ? microseconds : 0;
+    }
+
+    bool ChainIkSolverPos_NR_Broyden::pseudoInverse()
+    {
+        svd.compute(jac.data);
+        if (svd.info() != Eigen::Success)
+            return false;
+        // jac_pinv = V * S^-1 * U^T, with the small singular values truncated
+        const Eigen::VectorXd& S = svd.singularValues();
+        for (Eigen::Index i = 0; i < S.size(); ++i)
+            V_S.col(i) = svd.matrixV().col(i) * (std::fabs(S(i)) < SVD_EPS ? 0.0 : 1.0 / S(i));
+        jac_pinv.noalias() = V_S * svd.matrixU().transpose();
+        return true;
+    }
+
+    int ChainIkSolverPos_NR_Broyden::CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE_ITER(last_nr_of_iter);
+        if (nj != chain.getNrOfJoints())
+            return (error = E_NOT_UP_TO_DATE);
+
+        if (q_init.rows() != nj || q_out.rows() != nj)
+            return (error = E_SIZE_MISMATCH);
+
+        const bool timed = time_budget > 0;
+        std::chrono::steady_clock::time_point deadline;
+        if (timed)
+            deadline = std::chrono::steady_clock::now() +
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::micro>(time_budget));
+        double best_difference = std::numeric_limits<double>::infinity();
+
+        last_nr_of_jacobians = 0;
+        last_nr_of_updates = 0;
+        q_out = q_init;
+        if (E_NOERROR > fksolver.JntToCart(q_out, f))
+            return (error = E_FKSOLVERPOS_FAILED);
+        delta_twist = diff(f, p_in);
+        last_difference = std::hypot(delta_twist.vel.Norm(), delta_twist.rot.Norm());
+
+        // the pseudo-inverse is recomputed when it is not valid yet, after too many
+        // updates, or when an updated pseudo-inverse stalled.
+        bool refresh = true;
+        std::size_t nr_of_updates = 0;
+        for (std::size_t i = 0; i < maxiter; ++i) {
+            last_nr_of_iter = i;
+            if (Equal(delta_twist, Twist::Zero(), eps))
+                return (error = E_NOERROR);
+
+            if (timed) {
+                if (last_difference < best_difference) {
+                    best_difference = last_difference;
+                    q_best = q_out;
+                }
+                if (std::chrono::steady_clock::now() > deadline) {
+                    q_out = q_best;
+                    last_difference = best_difference;
+                    return (error = E_TIMEOUT);
+                }
+            }
+
+            const bool exact = refresh || last_difference > broyden_threshold || nr_of_updates >= refresh_interval;
+            if (exact) {
+                if (E_NOERROR > jnt2jac.JntToJac(q_out, jac))
+                    return (error = E_JNTTOJACSOLVER_FAILED);
+                if (!pseudoInverse())
+                    return (error = E_SVD_FAILED);
+                ++last_nr_of_jacobians;
+                nr_of_updates = 0;
+                refresh = false;
+            }
+
+            twistToVector(delta_twist, delta_x);
+            delta_q.noalias() = jac_pinv * delta_x;
+            q_prev = q_out;
+            q_out.data += delta_q;
+            if (E_NOERROR > fksolver.JntToCart(q_out, f))
+                return (error = E_FKSOLVERPOS_FAILED);
+            const Twist previous_twist = delta_twist;
+            const double previous_difference = last_difference;
+            delta_twist = diff(f, p_in);
+            last_difference = std::hypot(delta_twist.vel.Norm(), delta_twist.rot.Norm());
+
+            if (!exact && last_difference > STALL_RATIO * previous_difference) {
+                // the updated pseudo-inverse stalled: undo the step, use the exact Jacobian
+                q_out = q_prev;
+                delta_twist = previous_twist;
+                last_difference = previous_difference;
+                refresh = true;
+                continue;
+            }
+
+            if (last_difference <= broyden_threshold) {
+                // Broyden update with the observed change of the pose, delta_x = e_prev - e
+                for (int k = 0; k < 3; ++k) {
+                    delta_x(k) = previous_twist.vel(k) - delta_twist.vel(k);
+                    delta_x(3 + k) = previous_twist.rot(k) - delta_twist.rot(k);
+                }
+                const double dx2 = delta_x.squaredNorm();
+                if (dx2 > 0) {
+                    correction = delta_q;
+                    correction.noalias() -= jac_pinv * delta_x;
+                    correction /= dx2;
+                    jac_pinv.noalias() += correction * delta_x.transpose();
+                    ++last_nr_of_updates;
+                    ++nr_of_updates;
+                }
+            }
+        }
+        last_nr_of_iter = maxiter;
+        return (error = E_MAX_ITERATIONS_EXCEEDED);
+    }
+
+    const char* ChainIkSolverPos_NR_Broyden::strError(const int error) const
+    {
+        if (E_FKSOLVERPOS_FAILED == error) return "Child FK solver failed";
+        else if (E_JNTTOJACSOLVER_FAILED == error) return "Child Jacobian solver failed";
+        else return SolverI::strError(error);
+    }
+}
@@ -0,0 +1,138 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDLCHAINIKSOLVERPOS_NR_BROYDEN_HPP
+#define KDLCHAINIKSOLVERPOS_NR_BROYDEN_HPP
+
+#include "chainiksolver.hpp"
+#include "chainfksolver.hpp"
+#include "chainjnttojacsolver.hpp"
+
+#include <Eigen/SVD>
+
+namespace KDL {
+
+    /**
+     * Newton-Raphson inverse position kinematics with quasi-Newton (Broyden)
+     * updates of the pseudo-inverse of the Jacobian.
+     *
+     * Far from the goal every iteration uses the exact Jacobian and its
+     * pseudo-inverse, as ChainIkSolverPos_NR with ChainIkSolverVel_pinv does.
+     * Once the residual is below \a broyden_threshold, the pseudo-inverse
+     * \f$ H \f$ is updated with the rank-1 ("bad") Broyden update
+     * \f$ H \leftarrow H + (\Delta q - H \Delta x) \Delta x^T / \Delta x^T \Delta x \f$
+     * instead, with \f$ \Delta x \f$ the change of the pose caused by the
+     * step \f$ \Delta q \f$.  The exact Jacobian is recomputed every
+     * \a refresh_interval iterations, and after a step that did not reduce
+     * the residual enough; such a step is undone.
+     *
+     * @ingroup KinematicFamily
+     */
+    class ChainIkSolverPos_NR_Broyden : public ChainIkSolverPos
+    {
+    public:
+        static const int E_FKSOLVERPOS_FAILED = -100; //! Child FK solver failed
+        static const int E_JNTTOJACSOLVER_FAILED = -101; //! Child Jacobian solver failed
+
+        /**
+         * @param chain the chain to calculate the inverse position for
+         * @param fksolver a forward position kinematics solver for that chain
+         * @param maxiter the maximum number of iterations, default: 100
+         * @param eps the precision for the position, used to end the
+         * iterations, default: 1e-6
+         * @param broyden_threshold norm of the residual twist below which the
+         * pseudo-inverse is updated instead of recomputed, default: 1e-2
+         * @param refresh_interval maximum number of consecutive updates before
+         * the exact Jacobian is recomputed, default: 5
+         */
+        ChainIkSolverPos_NR_Broyden(const Chain& chain, ChainFkSolverPos& fksolver,
+                                    std::size_t maxiter=100, double eps=1e-6,
+                                    double broyden_threshold=1e-2, std::size_t refresh_interval=5);
+        /// Shares the immutable \a chain with other solvers instead of copying it.
+        ChainIkSolverPos_NR_Broyden(const ChainConstPtr& chain, ChainFkSolverPos& fksolver,
+                                    std::size_t maxiter=100, double eps=1e-6,
+                                    double broyden_threshold=1e-2, std::size_t refresh_interval=5);
+        ~ChainIkSolverPos_NR_Broyden();
+
+        /**
+         * Find an output joint pose \a q_out, given a starting joint pose
+         * \a q_init and a desired cartesian pose \a p_in
+         *
+         * @return:
+         *  E_NOERROR=solution converged to <eps in maxiter
+         *  E_MAX_ITERATIONS_EXCEEDED=solution did not converge in maxiter
+         *  E_SVD_FAILED=the pseudo-inverse could not be computed
+         *  E_TIMEOUT=the time budget was exceeded, q_out is the best configuration so far
+         */
+        virtual int CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out);
+
+        /**
+         * Sets a wall-clock budget for one call of CartToJnt in microseconds,
+         * as ChainIkSolverPos_NR::setTimeBudget.  0 (default) disables it.
+         */
+        void setTimeBudget(double microseconds);
+
+        /// Norm of the twist from the pose of q_out to the goal after the last call.
+        double getLastDifference() const { return last_difference; }
+        /// Number of iterations of the last call.
+        std::size_t getLastNrOfIter() const { return last_nr_of_iter; }
+        /// Number of exact Jacobians (and pseudo-inverses) computed during the last call.
+        std::size_t getLastNrOfJacobians() const { return last_nr_of_jacobians; }
+        /// Number of Broyden updates of the pseudo-inverse during the last call.
+        std::size_t getLastNrOfUpdates() const { return last_nr_of_updates; }
+
+        /// @copydoc KDL::SolverI::strError()
+        virtual const char* strError(const int error) const;
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+    private:
+        // computes the pseudo-inverse of jac into jac_pinv
+        bool pseudoInverse();
+
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
+
+        std::size_t nj;
+        ChainFkSolverPos& fksolver;
+        ChainJntToJacSolver jnt2jac;
+        Jacobian jac;
+        Eigen::JacobiSVD<Eigen::MatrixXd> svd;
+        Eigen::MatrixXd jac_pinv;
+        Eigen::MatrixXd V_S;
+        Eigen::VectorXd delta_q;
+        Eigen::VectorXd delta_x;
+        Eigen::VectorXd correction;
+        JntArray q_prev;
+        JntArray q_best;
+        Frame f;
+        Twist delta_twist;
+
+        std::size_t maxiter;
+        double eps;
+        double broyden_threshold;
+        std::size_t refresh_interval;
+        double time_budget;
+
+        double last_difference;
+        std::size_t last_nr_of_iter;
+        std::size_t last_nr_of_jacobians;
+        std::size_t last_nr_of_updates;
+    };
+
+}
+
+#endif
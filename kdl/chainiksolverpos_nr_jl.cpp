@@ -23,28 +23,44 @@
 
 #include "chainiksolverpos_nr_jl.hpp"
 
+#include <chrono>
+#include <cmath>
 #include <limits>
 
 namespace KDL
 {
     ChainIkSolverPos_NR_JL::ChainIkSolverPos_NR_JL(const Chain& _chain, const JntArray& _q_min, const JntArray& _q_max, ChainFkSolverPos& _fksolver,ChainIkSolverVel& _iksolver,
                                              std::size_t _maxiter, double _eps):
-        chain(_chain), nj(chain.getNrOfJoints()),
+        ChainIkSolverPos_NR_JL(std::make_shared<const Chain>(_chain), _q_min, _q_max, _fksolver, _iksolver, _maxiter, _eps)
+    {
+    }
+
+    ChainIkSolverPos_NR_JL::ChainIkSolverPos_NR_JL(const ChainConstPtr& _chain, const JntArray& _q_min, const JntArray& _q_max, ChainFkSolverPos& _fksolver,ChainIkSolverVel& _iksolver,
+                                             std::size_t _maxiter, double _eps):
+        chain_ptr(_chain),
+        chain(*chain_ptr), nj(chain.getNrOfJoints()),
         q_min(_q_min), q_max(_q_max),
-        iksolver(_iksolver), fksolver(_fksolver),
-        delta_q(_chain.getNrOfJoints()),
-        maxiter(_maxiter),eps(_eps)
+        ws_(nj, _fksolver, _iksolver),
+        maxiter(_maxiter),eps(_eps),time_budget(0),
+        last_difference(0),last_nr_of_iter(0)
     {
 
     }
 
     ChainIkSolverPos_NR_JL::ChainIkSolverPos_NR_JL(const Chain& _chain, ChainFkSolverPos& _fksolver,ChainIkSolverVel& _iksolver,
             std::size_t _maxiter, double _eps):
-         chain(_chain), nj(chain.getNrOfJoints()),
+         ChainIkSolverPos_NR_JL(std::make_shared<const Chain>(_chain), _fksolver, _iksolver, _maxiter, _eps)
+    {
+    }
+
+    ChainIkSolverPos_NR_JL::ChainIkSolverPos_NR_JL(const ChainConstPtr& _chain, ChainFkSolverPos& _fksolver,ChainIkSolverVel& _iksolver,
+            std::size_t _maxiter, double _eps):
+         chain_ptr(_chain),
+         chain(*chain_ptr), nj(chain.getNrOfJoints()),
          q_min(nj), q_max(nj),
-         iksolver(_iksolver), fksolver(_fksolver),
-         delta_q(nj),
-         maxiter(_maxiter),eps(_eps)
+         ws_(nj, _fksolver, _iksolver),
+         maxiter(_maxiter),eps(_eps),time_budget(0),
+         last_difference(0),last_nr_of_iter(0)
     {
         q_min.data.setConstant(std::numeric_limits<double>::min());
         q_max.data.setConstant(std::numeric_limits<double>::max());
@@ -54,33 +70,83 @@ namespace KDL
        nj = chain.getNrOfJoints();
        q_min.data.conservativeResizeLike(Eigen::VectorXd::Constant(nj,std::numeric_limits<double>::min()));
        q_max.data.conservativeResizeLike(Eigen::VectorXd::Constant(nj,std::numeric_limits<double>::max()));
-       iksolver.updateInternalDataStructures();
-       fksolver.updateInternalDataStructures();
-       delta_q.resize(nj);
+       ws_.iksolver.updateInternalDataStructures();
+       ws_.fksolver.updateInternalDataStructures();
+       ws_.resize(nj);
+    }
+
+    ChainIkSolverPos_NR_JL::Workspace::Workspace(std::size_t nj, ChainFkSolverPos& _fksolver, ChainIkSolverVel& _iksolver):
+        fksolver(_fksolver), iksolver(_iksolver),
+        delta_q(nj), q_best(nj), last_difference(0), last_nr_of_iter(0)
+    {
+    }
+
+    void ChainIkSolverPos_NR_JL::Workspace::resize(std::size_t nj)
+    {
+        delta_q.resize(nj);
+        q_best.resize(nj);
+    }
+
+    void ChainIkSolverPos_NR_JL::setTimeBudget(double microseconds)
+    {
+        time_budget = microseconds > 0 ? microseconds : 0;
     }
 
     int ChainIkSolverPos_NR_JL::CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out)
     {
+        KDL_SOLVER_TELEMETRY_SCOPE_ITER(last_nr_of_iter);
+        error = CartToJnt(q_init, p_in, q_out, ws_);
+        last_difference = ws_.last_difference;
+        last_nr_of_iter = ws_.last_nr_of_iter;
+        return error;
+    }
+
+    int ChainIkSolverPos_NR_JL::CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out, Workspace& ws) const
+    {
+        ws.last_nr_of_iter = 0;
+
         if(nj != chain.getNrOfJoints())
-            return (error = E_NOT_UP_TO_DATE);
+            return E_NOT_UP_TO_DATE;
 
-        if(nj != q_init.rows() || nj != q_out.rows() || nj != q_min.rows() || nj != q_max.rows())
-            return (error = E_SIZE_MISMATCH);
+        if(nj != q_init.rows() || nj != q_out.rows() || nj != q_min.rows() || nj != q_max.rows() || nj != ws.delta_q.rows())
+            return E_SIZE_MISMATCH;
 
         q_out = q_init;
 
+        const bool timed = time_budget > 0;
+        std::chrono::steady_clock::time_point deadline;
+        if (timed)
+            deadline = std::chrono::steady_clock::now() +
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::micro>(time_budget));
+        double best_difference = std::numeric_limits<double>::infinity();
+
         std::size_t i;
         for(i=0;i<maxiter;i++){
-            if ( fksolver.JntToCart(q_out,f) < 0)
-                return (error = E_FKSOLVERPOS_FAILED);
-            delta_twist = diff(f,p_in);
+            ws.last_nr_of_iter = i;
+            if ( ws.fksolver.JntToCart(q_out,ws.f) < 0)
+                return E_FKSOLVERPOS_FAILED;
+            ws.delta_twist = diff(ws.f,p_in);
+            ws.last_difference = std::hypot(ws.delta_twist.vel.Norm(), ws.delta_twist.rot.Norm());
 
-            if(Equal(delta_twist,Twist::Zero(),eps))
+            if(Equal(ws.delta_twist,Twist::Zero(),eps))
                 break;
 
-            if ( iksolver.CartToJnt(q_out,delta_twist,delta_q) < 0)
-                return (error = E_IKSOLVERVEL_FAILED);
-            Add(q_out,delta_q,q_out);
+            if (timed) {
+                // clamping at the limits makes the residual non-monotonic
+                if (ws.last_difference < best_difference) {
+                    best_difference = ws.last_difference;
+                    ws.q_best = q_out;
+                }
+                if (std::chrono::steady_clock::now() > deadline) {
+                    q_out = ws.q_best;
+                    ws.last_difference = best_difference;
+                    return E_TIMEOUT;
+                }
+            }
+
+            if ( ws.iksolver.CartToJnt(q_out,ws.delta_twist,ws.delta_q) < 0)
+                return E_IKSOLVERVEL_FAILED;
+            Add(q_out,ws.delta_q,q_out);
 
             for(std::size_t j=0; j<q_min.rows(); j++) {
                 if(q_out(j) < q_min(j))
@@ -93,11 +159,12 @@ namespace KDL
                     q_out(j) = q_max(j);
             }
         }
+        ws.last_nr_of_iter = i;
 
         if(i!=maxiter)
-            return (error = E_NOERROR);
+            return E_NOERROR;
         else
-            return (error = E_MAX_ITERATIONS_EXCEEDED);
+            return E_MAX_ITERATIONS_EXCEEDED;
     }
 
     int ChainIkSolverPos_NR_JL::setJointLimits(const JntArray& q_min_in, const JntArray& q_max_in) {
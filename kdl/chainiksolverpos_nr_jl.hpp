@@ -44,6 +44,31 @@ namespace KDL {
         static const int E_IKSOLVERVEL_FAILED = -100; //! Child IK solver vel failed
         static const int E_FKSOLVERPOS_FAILED = -101; //! Child FK solver failed
 
+        /**
+         * \brief Everything that CartToJnt modifies.
+         *
+         * With the const variant of CartToJnt a single solver can be
+         * shared by several threads, each of them using its own workspace.
+         * The child solvers keep state of their own, so a workspace refers
+         * to its own forward position and inverse velocity solvers, e.g.
+         * constructed for the same ChainConstPtr.
+         */
+        struct Workspace {
+            Workspace(std::size_t nj, ChainFkSolverPos& fksolver, ChainIkSolverVel& iksolver);
+            void resize(std::size_t nj);
+
+            ChainFkSolverPos& fksolver;
+            ChainIkSolverVel& iksolver;
+            JntArray delta_q;
+            Frame f;
+            Twist delta_twist;
+            JntArray q_best;
+            /// residual of the last call, see getLastDifference()
+            double last_difference;
+            /// number of iterations of the last call
+            std::size_t last_nr_of_iter;
+        };
+
         /**
          * Constructor of the solver, it needs the chain, a forward
          * position kinematics solver and an inverse velocity
@@ -62,6 +87,8 @@ namespace KDL {
          * @return
          */
         ChainIkSolverPos_NR_JL(const Chain& chain,const JntArray& q_min, const JntArray& q_max, ChainFkSolverPos& fksolver,ChainIkSolverVel& iksolver,std::size_t maxiter=100,double eps=1e-6);
+        /// Shares the immutable \a chain with other solvers instead of copying it.
+        ChainIkSolverPos_NR_JL(const ChainConstPtr& chain,const JntArray& q_min, const JntArray& q_max, ChainFkSolverPos& fksolver,ChainIkSolverVel& iksolver,std::size_t maxiter=100,double eps=1e-6);
 
         /**
          * Constructor of the solver, it needs the chain, a forward
@@ -79,6 +106,8 @@ namespace KDL {
          * @return
          */
         ChainIkSolverPos_NR_JL(const Chain& chain, ChainFkSolverPos& fksolver,ChainIkSolverVel& iksolver,std::size_t maxiter=100,double eps=1e-6);
+        /// Shares the immutable \a chain with other solvers instead of copying it.
+        ChainIkSolverPos_NR_JL(const ChainConstPtr& chain, ChainFkSolverPos& fksolver,ChainIkSolverVel& iksolver,std::size_t maxiter=100,double eps=1e-6);
 
         ~ChainIkSolverPos_NR_JL();
 
@@ -91,9 +120,35 @@ namespace KDL {
          * @return E_MAX_ITERATIONS_EXCEEDED if the maximum number of iterations was exceeded before a result was found
          *         E_NOT_UP_TO_DATE if the internal data is not up to date with the chain
          *         E_SIZE_MISMATCH if the size of the input/output data does not match the chain.
+         *         E_TIMEOUT if the time budget was exceeded, q_out is then the best configuration so far.
          */
         virtual int CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out);
 
+        /**
+         * Same as above, with the external workspace \a ws instead of the
+         * internal one.  Neither the error nor the diagnostics of the
+         * solver are updated, they are left in \a ws.
+         */
+        int CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out, Workspace& ws) const;
+
+        /**
+         * Sets a wall-clock budget for one call of CartToJnt in microseconds.
+         * The clock is read once per iteration.  When the budget is exceeded,
+         * CartToJnt returns E_TIMEOUT with the configuration with the smallest
+         * residual found so far.  0 (default) disables the budget; negative
+         * values are treated as 0.
+         */
+        void setTimeBudget(double microseconds);
+
+        /**
+         * Norm of the twist from the pose of the last evaluated configuration
+         * to the goal.  After E_TIMEOUT it is the residual of the returned q_out.
+         */
+        double getLastDifference() const { return last_difference; }
+
+        /// Number of iterations of the last call.
+        std::size_t getLastNrOfIter() const { return last_nr_of_iter; }
+
         /**
          * Function to set the joint limits.
          * @param q_min minimum values for the joints
@@ -109,18 +164,18 @@ namespace KDL {
         const char* strError(const int error) const;
 
     private:
-        const Chain chain;
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
         std::size_t nj;
         JntArray q_min;
         JntArray q_max;
-        ChainIkSolverVel& iksolver;
-        ChainFkSolverPos& fksolver;
-        JntArray delta_q;
+        Workspace ws_;
         std::size_t maxiter;
         double eps;
+        double time_budget;
 
-        Frame f;
-        Twist delta_twist;
+        double last_difference;
+        std::size_t last_nr_of_iter;
 
     };
 
@@ -0,0 +1,91 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainiksolverpos_seeddatabase.hpp"
+
+namespace KDL
+{
+    ChainIkSolverPos_SeedDatabase::ChainIkSolverPos_SeedDatabase(const Chain& _chain, const ChainIkSeedDatabase& _database,
+                                                                 ChainIkSolverPos& _iksolver, std::size_t _nr_of_seeds):
+        ChainIkSolverPos_SeedDatabase(std::make_shared<const Chain>(_chain), _database, _iksolver, _nr_of_seeds)
+    {
+    }
+
+    ChainIkSolverPos_SeedDatabase::ChainIkSolverPos_SeedDatabase(const ChainConstPtr& _chain, const ChainIkSeedDatabase& _database,
+                                                                 ChainIkSolverPos& _iksolver, std::size_t _nr_of_seeds):
+        chain_ptr(_chain),
+        chain(*chain_ptr), nj(chain.getNrOfJoints()),
+        database(_database), iksolver(_iksolver), fksolver(chain_ptr),
+        indices(_nr_of_seeds), distances(_nr_of_seeds),
+        seed(nj),
+        last_seed(-1), last_nr_of_attempts(0)
+    {
+    }
+
+    ChainIkSolverPos_SeedDatabase::~ChainIkSolverPos_SeedDatabase()
+    {
+    }
+
+    void ChainIkSolverPos_SeedDatabase::updateInternalDataStructures()
+    {
+        nj = chain.getNrOfJoints();
+        fksolver.updateInternalDataStructures();
+        iksolver.updateInternalDataStructures();
+        seed.resize(nj);
+    }
+
+    void ChainIkSolverPos_SeedDatabase::setNrOfSeeds(std::size_t nr_of_seeds)
+    {
+        indices.resize(nr_of_seeds);
+        distances.resize(nr_of_seeds);
+    }
+
+    int ChainIkSolverPos_SeedDatabase::CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE_ITER(last_nr_of_attempts);
+        if (nj != chain.getNrOfJoints())
+            return (error = E_NOT_UP_TO_DATE);
+
+        if (q_init.rows() != nj || q_out.rows() != nj || database.getNrOfJoints() != nj)
+            return (error = E_SIZE_MISMATCH);
+
+        if (fksolver.JntToCart(q_init, f) < 0)
+            return (error = E_UNDEFINED);
+        // approximate neighbours are good enough as seeds, and much faster to find
+        const std::size_t found = database.findNearest(p_in, indices, distances, 1.0);
+        const bool init_first = found == 0 || database.distance(f, p_in) <= distances[0];
+
+        last_nr_of_attempts = 0;
+        int rc = E_NO_CONVERGE;
+        for (std::size_t k = 0; k <= found; ++k) {
+            // attempt k is q_init when it goes first, or after all samples otherwise
+            const bool use_init = init_first ? k == 0 : k == found;
+            if (use_init) {
+                seed = q_init;
+                last_seed = -1;
+            } else {
+                const std::size_t index = indices[init_first ? k - 1 : k];
+                database.getJointPositions(index, seed);
+                last_seed = (int)index;
+            }
+            ++last_nr_of_attempts;
+            rc = iksolver.CartToJnt(seed, p_in, q_out);
+            if (rc >= E_NOERROR)
+                break;
+        }
+        return (error = rc);
+    }
+}
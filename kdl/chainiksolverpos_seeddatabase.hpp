@@ -0,0 +1,95 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDLCHAINIKSOLVERPOS_SEEDDATABASE_HPP
+#define KDLCHAINIKSOLVERPOS_SEEDDATABASE_HPP
+
+#include "chainiksolver.hpp"
+#include "chainfksolverpos_recursive.hpp"
+#include "chainikseeddatabase.hpp"
+
+#include <vector>
+
+namespace KDL {
+
+    /**
+     * Inverse position kinematics that seeds another position solver (e.g.
+     * ChainIkSolverPos_LMA or ChainIkSolverPos_NR) with the configurations of
+     * a ChainIkSeedDatabase whose tip pose is nearest to the goal.
+     *
+     * q_init is tried first when its tip pose is at least as close to the goal
+     * as the nearest sample of the database, and last otherwise.  The first
+     * attempt that succeeds is returned.
+     *
+     * @ingroup KinematicFamily
+     */
+    class ChainIkSolverPos_SeedDatabase : public ChainIkSolverPos
+    {
+    public:
+        /**
+         * @param chain the chain to calculate the inverse position for
+         * @param database samples of \a chain, it must outlive the solver
+         * @param iksolver the position solver that is seeded, for the same chain
+         * @param nr_of_seeds maximum number of database samples tried per call
+         */
+        ChainIkSolverPos_SeedDatabase(const Chain& chain, const ChainIkSeedDatabase& database,
+                                      ChainIkSolverPos& iksolver, std::size_t nr_of_seeds=4);
+        /// Shares the immutable \a chain with other solvers instead of copying it.
+        ChainIkSolverPos_SeedDatabase(const ChainConstPtr& chain, const ChainIkSeedDatabase& database,
+                                      ChainIkSolverPos& iksolver, std::size_t nr_of_seeds=4);
+        ~ChainIkSolverPos_SeedDatabase();
+
+        /**
+         * Find an output joint pose \a q_out, given a starting joint pose
+         * \a q_init and a desired cartesian pose \a p_in
+         *
+         * @return the result of the first successful attempt of the seeded
+         *  solver, otherwise the error of its last attempt.
+         *  E_SIZE_MISMATCH if the database does not match the chain.
+         */
+        virtual int CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out);
+
+        /// Sets the maximum number of database samples tried per call.
+        void setNrOfSeeds(std::size_t nr_of_seeds);
+
+        /// Database index of the seed of the last q_out, -1 for q_init.
+        int getLastSeed() const { return last_seed; }
+        /// Number of attempts of the seeded solver during the last call.
+        std::size_t getLastNrOfAttempts() const { return last_nr_of_attempts; }
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+    private:
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
+        std::size_t nj;
+        const ChainIkSeedDatabase& database;
+        ChainIkSolverPos& iksolver;
+        ChainFkSolverPos_recursive fksolver;
+
+        std::vector<std::size_t> indices;
+        std::vector<double> distances;
+        JntArray seed;
+        Frame f;
+
+        int last_seed;
+        std::size_t last_nr_of_attempts;
+    };
+
+}
+
+#endif
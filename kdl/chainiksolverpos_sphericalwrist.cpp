@@ -0,0 +1,473 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainiksolverpos_sphericalwrist.hpp"
+#include "chainjnttojacsolver.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace KDL
+{
+    // Paden-Kahan subproblems.  All axes are unit vectors w through a point r.
+
+    // Subproblem 1: angle rotating p onto q.  Returns false if p lies on the axis;
+    // close to the axis the angle is dominated by rounding errors, hence the margin.
+    static bool subproblem1(const Vector& w, const Vector& r, const Vector& p, const Vector& q, double& theta)
+    {
+        Vector u = p - r;
+        Vector v = q - r;
+        u = u - w * dot(w, u);
+        v = v - w * dot(w, v);
+        if (u.Norm() < 1e-7 || v.Norm() < 1e-7)
+            return false;
+        theta = atan2(dot(w, u * v), dot(u, v));
+        return true;
+    }
+
+    // Subproblem 2: angles t1, t2 with exp(w1 t1) exp(w2 t2) p = q for two axes
+    // intersecting in r.  If the intermediate point lies on axis 1, t1 is set to t1_singular.
+    static int subproblem2(const Vector& w1, const Vector& w2, const Vector& r, const Vector& p, const Vector& q,
+                           double tol, double t1_singular, double t1[2], double t2[2])
+    {
+        const Vector u = p - r;
+        const Vector v = q - r;
+        const double c12 = dot(w1, w2);
+        const double den = c12 * c12 - 1;
+        const double alpha = (c12 * dot(w2, u) - dot(w1, v)) / den;
+        const double beta = (c12 * dot(w1, v) - dot(w2, u)) / den;
+        const Vector w12 = w1 * w2;
+        double gamma2 = (dot(u, u) - alpha * alpha - beta * beta - 2 * alpha * beta * c12) / dot(w12, w12);
+        if (gamma2 < -tol)
+            return 0;
+        // below the rounding noise of gamma2 the two solutions coincide
+        const double gamma = gamma2 > 1e-14 ? sqrt(gamma2) : 0;
+        const int n = gamma > 0 ? 2 : 1;
+        for (int i = 0; i < n; ++i) {
+            const Vector c = r + w1 * alpha + w2 * beta + w12 * (i == 0 ? gamma : -gamma);
+            if (!subproblem1(w2, r, p, c, t2[i]))
+                t2[i] = 0;
+            if (!subproblem1(w1, r, c, q, t1[i]))
+                t1[i] = t1_singular;
+        }
+        return n;
+    }
+
+    // Subproblem 3: angles rotating p to a distance delta from q.
+    static int subproblem3(const Vector& w, const Vector& r, const Vector& p, const Vector& q, double delta,
+                           double tol, double theta[2])
+    {
+        Vector u = p - r;
+        Vector v = q - r;
+        const double dw = dot(w, p - q);
+        u = u - w * dot(w, u);
+        v = v - w * dot(w, v);
+        const double nu = u.Norm();
+        const double nv = v.Norm();
+        if (nu < 1e-12 || nv < 1e-12)
+            return 0;
+        const double theta0 = atan2(dot(w, u * v), dot(u, v));
+        double c = (nu * nu + nv * nv - (delta * delta - dw * dw)) / (2 * nu * nv);
+        if (c > 1 + tol || c < -1 - tol)
+            return 0;
+        c = c > 1 ? 1 : (c < -1 ? -1 : c);
+        const double a = acos(c);
+        theta[0] = theta0 - a;
+        theta[1] = theta0 + a;
+        return (a > tol && a < PI - tol) ? 2 : 1;
+    }
+
+    // Subproblem 4: angles rotating p into the plane dot(n, x) = d.  If p lies on
+    // the axis and in the plane, the single solution theta_singular is returned.
+    static int subproblem4(const Vector& w, const Vector& r, const Vector& p, const Vector& n, double d,
+                           double tol, double theta_singular, double theta[2])
+    {
+        const Vector u = p - r;
+        const Vector center = r + w * dot(w, u);
+        const Vector up = p - center;
+        const double a = dot(n, up);
+        const double b = dot(n, w * up);
+        const double c = d - dot(n, center);
+        const double rho = sqrt(a * a + b * b);
+        if (rho < 1e-12) {
+            if (fabs(c) > tol)
+                return 0;
+            theta[0] = theta_singular;
+            return 1;
+        }
+        double ratio = c / rho;
+        if (ratio > 1 + tol || ratio < -1 - tol)
+            return 0;
+        ratio = ratio > 1 ? 1 : (ratio < -1 ? -1 : ratio);
+        const double phi = atan2(b, a);
+        const double e = acos(ratio);
+        theta[0] = phi + e;
+        theta[1] = phi - e;
+        return (e > tol && e < PI - tol) ? 2 : 1;
+    }
+
+    // Intersection c of two axes, false if they are parallel or further apart than tol.
+    static bool intersection(const Vector& w1, const Vector& r1, const Vector& w2, const Vector& r2,
+                             double tol, Vector& c)
+    {
+        const double b = dot(w1, w2);
+        if ((w1 * w2).Norm() < tol)
+            return false;
+        const Vector w0 = r1 - r2;
+        const double d = dot(w1, w0);
+        const double e = dot(w2, w0);
+        const Vector c1 = r1 + w1 * ((b * e - d) / (1 - b * b));
+        const Vector c2 = r2 + w2 * ((e - b * d) / (1 - b * b));
+        if ((c1 - c2).Norm() > tol)
+            return false;
+        c = (c1 + c2) / 2;
+        return true;
+    }
+
+    // Distance of the point p from the axis w through r.
+    static double distance(const Vector& w, const Vector& r, const Vector& p)
+    {
+        const Vector u = p - r;
+        return (u - w * dot(w, u)).Norm();
+    }
+
+    ChainIkSolverPos_SphericalWrist::ChainIkSolverPos_SphericalWrist(const Chain& _chain, double _eps):
+        ChainIkSolverPos_SphericalWrist(std::make_shared<const Chain>(_chain), _eps)
+    {
+    }
+
+    ChainIkSolverPos_SphericalWrist::ChainIkSolverPos_SphericalWrist(const ChainConstPtr& _chain, double _eps):
+        chain_ptr(_chain),
+        chain(*chain_ptr),
+        fksolver(chain_ptr),
+        eps(_eps),
+        supported(false),
+        parallel_axes(false),
+        q_tmp(chain.getNrOfJoints())
+    {
+        analyse();
+    }
+
+    ChainIkSolverPos_SphericalWrist::~ChainIkSolverPos_SphericalWrist()
+    {
+    }
+
+    void ChainIkSolverPos_SphericalWrist::updateInternalDataStructures()
+    {
+        q_tmp.resize(chain.getNrOfJoints());
+        analyse();
+    }
+
+    void ChainIkSolverPos_SphericalWrist::analyse()
+    {
+        supported = false;
+        parallel_axes = false;
+        if (chain.getNrOfJoints() != 6)
+            return;
+        for (std::size_t i = 0, j = 0; i < chain.getNrOfSegments(); ++i) {
+            const Joint& joint = chain.getSegment(i).getJoint();
+            switch (joint.getType()) {
+            case Joint::Fixed:
+                continue;
+            case Joint::RotAxis:
+            case Joint::RotX:
+            case Joint::RotY:
+            case Joint::RotZ:
+                lower[j] = joint.getLowerPositionLimit();
+                upper[j] = joint.getUpperPositionLimit();
+                ++j;
+                break;
+            default:
+                return;
+            }
+        }
+
+        // joint axes at q=0 from the Jacobian: the column of joint i is the twist
+        // (w x (tip - p), w) of a rotation w about an axis through p.
+        JntArray q0(6);
+        Jacobian jac(6);
+        Frame home;
+        ChainJntToJacSolver jacsolver(chain_ptr);
+        if (jacsolver.JntToJac(q0, jac) != E_NOERROR || fksolver.JntToCart(q0, home) != E_NOERROR)
+            return;
+        home_inv = home.Inverse();
+        for (unsigned int i = 0; i < 6; ++i) {
+            const Twist t = jac.getColumn(i);
+            const double s = t.rot.Norm();
+            if (s < eps)
+                return;
+            scale[i] = s;
+            axis[i] = t.rot / s;
+            point[i] = home.p + (t.rot * t.vel) / (s * s);
+        }
+
+        if (analyseSphericalWrist()) {
+            supported = true;
+        } else if (analyseParallelAxes()) {
+            supported = true;
+            parallel_axes = true;
+        }
+    }
+
+    bool ChainIkSolverPos_SphericalWrist::analyseSphericalWrist()
+    {
+        // spherical wrist: axes 4 and 5 intersect, axis 6 passes through their intersection.
+        Vector c;
+        if (!intersection(axis[3], point[3], axis[4], point[4], eps, c) || (axis[4] * axis[5]).Norm() < eps ||
+            distance(axis[5], point[5], c) > eps)
+            return false;
+
+        // parallel shoulder and elbow axes, base axis not parallel to them,
+        // wrist center not on the elbow axis.
+        if ((axis[1] * axis[2]).Norm() > eps || (axis[0] * axis[1]).Norm() < eps)
+            return false;
+        if (distance(axis[2], point[2], c) < eps)
+            return false;
+
+        wrist = c;
+        for (unsigned int i = 3; i < 6; ++i)
+            point[i] = wrist;
+        return true;
+    }
+
+    bool ChainIkSolverPos_SphericalWrist::analyseParallelAxes()
+    {
+        // axes 2 to 4 parallel and distinct, axes 1 and 5 not parallel to them.
+        if ((axis[1] * axis[2]).Norm() > eps || (axis[1] * axis[3]).Norm() > eps ||
+            (axis[0] * axis[1]).Norm() < eps || (axis[4] * axis[1]).Norm() < eps)
+            return false;
+        if (distance(axis[1], point[1], point[2]) < eps || distance(axis[2], point[2], point[3]) < eps)
+            return false;
+
+        // axes 5 and 6 intersect.
+        Vector c;
+        if (!intersection(axis[4], point[4], axis[5], point[5], eps, c))
+            return false;
+
+        wrist = c;
+        point[4] = point[5] = wrist;
+        return true;
+    }
+
+    static inline Frame exponential(const Vector& axis, const Vector& point, double theta)
+    {
+        const Rotation R = Rotation::Rot2(axis, theta);
+        return Frame(R, point - R * point);
+    }
+
+    std::size_t ChainIkSolverPos_SphericalWrist::solve(const Frame& p_in, const double ref[6], double theta[8][6]) const
+    {
+        return parallel_axes ? solveParallelAxes(p_in, ref, theta) : solveSphericalWrist(p_in, ref, theta);
+    }
+
+    std::size_t ChainIkSolverPos_SphericalWrist::solveSphericalWrist(const Frame& p_in, const double ref[6], double theta[8][6]) const
+    {
+        const Frame g = p_in * home_inv;
+        const Vector pw = g * wrist;
+        const Vector p5 = wrist + axis[5];
+        Vector p6 = axis[5] * axis[4];
+        p6.Normalize();
+        p6 = wrist + p6;
+
+        std::size_t n = 0;
+        double t1[2], t3[2], t4[2], t5[2];
+        // the wrist center fixes joint 1: rotating back by joint 1 leaves it at a constant
+        // coordinate along the (parallel) shoulder and elbow axes.
+        const int n1 = subproblem4(axis[0], point[0], pw, axis[1], dot(axis[1], wrist), eps, -ref[0], t1);
+        for (int i1 = 0; i1 < n1; ++i1) {
+            const double th1 = -t1[i1];
+            const Frame e1 = exponential(axis[0], point[0], th1);
+            const Vector x = e1.Inverse(pw);
+            // the elbow fixes the distance between the shoulder axis and the wrist center
+            const int n3 = subproblem3(axis[2], point[2], wrist, point[1], (x - point[1]).Norm(), eps, t3);
+            for (int i3 = 0; i3 < n3; ++i3) {
+                const Frame e3 = exponential(axis[2], point[2], t3[i3]);
+                double th2;
+                if (!subproblem1(axis[1], point[1], e3 * wrist, x, th2))
+                    th2 = ref[1];
+                const Frame g2 = (e1 * exponential(axis[1], point[1], th2) * e3).Inverse() * g;
+                const int n4 = subproblem2(axis[3], axis[4], wrist, p5, g2 * p5, eps, ref[3], t4, t5);
+                for (int i4 = 0; i4 < n4; ++i4) {
+                    const Frame g3 = (exponential(axis[3], wrist, t4[i4]) * exponential(axis[4], wrist, t5[i4])).Inverse() * g2;
+                    double th6;
+                    if (!subproblem1(axis[5], wrist, p6, g3 * p6, th6))
+                        th6 = ref[5];
+                    theta[n][0] = th1;
+                    theta[n][1] = th2;
+                    theta[n][2] = t3[i3];
+                    theta[n][3] = t4[i4];
+                    theta[n][4] = t5[i4];
+                    theta[n][5] = th6;
+                    ++n;
+                }
+            }
+        }
+        return n;
+    }
+
+    std::size_t ChainIkSolverPos_SphericalWrist::solveParallelAxes(const Frame& p_in, const double ref[6], double theta[8][6]) const
+    {
+        const Frame g = p_in * home_inv;
+        const Vector pw = g * wrist;
+        const Vector& n = axis[1];
+        // a point off axis 4, in the plane of the arm
+        Vector p4 = n * axis[4];
+        p4.Normalize();
+        p4 = point[3] + p4;
+
+        std::size_t n_sol = 0;
+        double t1[2], t3[2], t5[2];
+        // joints 2 to 4 do not change the coordinate along their axes, and joints 5 and
+        // 6 do not move their intersection: rotating back by joint 1 fixes it.
+        const int n1 = subproblem4(axis[0], point[0], pw, n, dot(n, wrist), eps, -ref[0], t1);
+        for (int i1 = 0; i1 < n1; ++i1) {
+            const double th1 = -t1[i1];
+            const Frame e1 = exponential(axis[0], point[0], th1);
+            const Frame g1 = e1.Inverse() * g;
+            // joints 2 to 4 keep their axis direction: joint 5 fixes the component
+            // of the direction of axis 6 along it.
+            const Vector a6 = g1.M * axis[5];
+            const int n5 = subproblem4(axis[4], Vector::Zero(), axis[5], n, dot(n, a6), eps, ref[4], t5);
+            for (int i5 = 0; i5 < n5; ++i5) {
+                const Rotation R5 = Rotation::Rot2(axis[4], t5[i5]);
+                double th6;
+                if (!subproblem1(axis[5], Vector::Zero(), g1.M.Inverse(n), R5.Inverse(n), th6))
+                    th6 = ref[5];
+                const Frame g234 = g1 * (exponential(axis[4], wrist, t5[i5]) * exponential(axis[5], wrist, th6)).Inverse();
+                // planar arm: the elbow fixes the distance between axes 2 and 4
+                const Vector x = g234 * point[3];
+                const int n3 = subproblem3(axis[2], point[2], point[3], point[1], (x - point[1]).Norm(), eps, t3);
+                for (int i3 = 0; i3 < n3; ++i3) {
+                    const Frame e3 = exponential(axis[2], point[2], t3[i3]);
+                    double th2;
+                    if (!subproblem1(axis[1], point[1], e3 * point[3], x, th2))
+                        th2 = ref[1];
+                    const Frame g4 = (exponential(axis[1], point[1], th2) * e3).Inverse() * g234;
+                    double th4;
+                    if (!subproblem1(axis[3], point[3], p4, g4 * p4, th4))
+                        th4 = ref[3];
+                    theta[n_sol][0] = th1;
+                    theta[n_sol][1] = th2;
+                    theta[n_sol][2] = t3[i3];
+                    theta[n_sol][3] = th4;
+                    theta[n_sol][4] = t5[i5];
+                    theta[n_sol][5] = th6;
+                    ++n_sol;
+                }
+            }
+        }
+        return n_sol;
+    }
+
+    bool ChainIkSolverPos_SphericalWrist::toJoints(const double theta[6], const JntArray* ref, JntArray& q) const
+    {
+        bool within = true;
+        for (unsigned int i = 0; i < 6; ++i) {
+            const double period = 2 * PI / scale[i];
+            double qi = theta[i] / scale[i];
+            if (ref)
+                qi += period * std::round(((*ref)(i) - qi) / period);
+            else
+                qi -= period * std::floor((qi + period / 2) / period);
+            if (lower[i] < upper[i] && (qi < lower[i] || qi > upper[i])) {
+                // first equivalent angle above the lower limit, then the one closest to the reference
+                double best = qi + period * std::ceil((lower[i] - qi) / period);
+                if (best > upper[i]) {
+                    within = false;
+                } else if (ref) {
+                    for (double c = best + period; c <= upper[i]; c += period)
+                        if (fabs(c - (*ref)(i)) < fabs(best - (*ref)(i)))
+                            best = c;
+                }
+                if (best <= upper[i])
+                    qi = best;
+            }
+            q(i) = qi;
+        }
+        return within;
+    }
+
+    int ChainIkSolverPos_SphericalWrist::CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        if (!supported)
+            return (error = E_NOT_IMPLEMENTED);
+        if (q_init.rows() != 6 || q_out.rows() != 6 || q_tmp.rows() != 6)
+            return (error = E_SIZE_MISMATCH);
+
+        double ref[6];
+        for (unsigned int i = 0; i < 6; ++i)
+            ref[i] = scale[i] * q_init(i);
+        double theta[8][6];
+        const std::size_t n = solve(p_in, ref, theta);
+
+        bool reachable = false;
+        double best = std::numeric_limits<double>::infinity();
+        for (std::size_t k = 0; k < n; ++k) {
+            const bool within = toJoints(theta[k], &q_init, q_tmp);
+            if (fksolver.JntToCart(q_tmp, f_tmp) != E_NOERROR || !Equal(f_tmp, p_in, eps))
+                continue;
+            reachable = true;
+            if (!within)
+                continue;
+            const double distance = (q_tmp.data - q_init.data).squaredNorm();
+            if (distance < best) {
+                best = distance;
+                q_out = q_tmp;
+            }
+        }
+        if (best < std::numeric_limits<double>::infinity())
+            return (error = E_NOERROR);
+        return (error = reachable ? E_OUT_OF_LIMITS : E_OUT_OF_REACH);
+    }
+
+    int ChainIkSolverPos_SphericalWrist::CartToJnt(const Frame& p_in, std::vector<JntArray>& q_sols)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        if (!supported)
+            return (error = E_NOT_IMPLEMENTED);
+
+        const double ref[6] = {0, 0, 0, 0, 0, 0};
+        double theta[8][6];
+        const std::size_t n = solve(p_in, ref, theta);
+
+        if (q_sols.size() < n)
+            q_sols.resize(n, JntArray(6));
+        bool reachable = false;
+        std::size_t m = 0;
+        for (std::size_t k = 0; k < n; ++k) {
+            if (q_sols[m].rows() != 6)
+                q_sols[m].resize(6);
+            const bool within = toJoints(theta[k], nullptr, q_sols[m]);
+            if (fksolver.JntToCart(q_sols[m], f_tmp) != E_NOERROR || !Equal(f_tmp, p_in, eps))
+                continue;
+            reachable = true;
+            if (within)
+                ++m;
+        }
+        q_sols.resize(m);
+        if (m > 0)
+            return (error = E_NOERROR);
+        return (error = reachable ? E_OUT_OF_LIMITS : E_OUT_OF_REACH);
+    }
+
+    const char* ChainIkSolverPos_SphericalWrist::strError(const int error) const
+    {
+        if (E_OUT_OF_REACH == error) return "The pose is out of reach";
+        else if (E_OUT_OF_LIMITS == error) return "No solution within the joint limits";
+        else return SolverI::strError(error);
+    }
+}
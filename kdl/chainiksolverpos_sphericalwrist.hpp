@@ -0,0 +1,145 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDLCHAINIKSOLVERPOS_SPHERICALWRIST_HPP
+#define KDLCHAINIKSOLVERPOS_SPHERICALWRIST_HPP
+
+#include "chainiksolver.hpp"
+#include "chainfksolverpos_recursive.hpp"
+
+#include <vector>
+
+namespace KDL {
+
+    /**
+     * \brief Closed-form inverse position kinematics for wrist-partitioned 6R arms.
+     *
+     * The constructor inspects the chain at q=0 and accepts chains with six
+     * revolute joints (any number of fixed segments) of one of two kinds:
+     *   - spherical wrist: the last three joint axes intersect in one point,
+     *     the second and third joint axes are parallel (shoulder and elbow)
+     *     and the first joint axis is not parallel to them.  This covers the
+     *     usual industrial layouts (PUMA, KUKA KR, ABB, Fanuc, Staubli, ...)
+     *     including shoulder and elbow offsets.
+     *   - three parallel axes: the second, third and fourth joint axes are
+     *     parallel, the first and the fifth axis are not parallel to them
+     *     and the fifth and sixth axes intersect.  This covers the Universal
+     *     Robots layout and its derivatives.
+     *
+     * The kinematics are written in product of exponentials form and
+     * decomposed into the Paden-Kahan subproblems.  With a spherical wrist
+     * the wrist center fixes joints 1 to 3 (subproblems 4, 3 and 1), the
+     * orientation fixes the wrist joints 4 to 6 (subproblems 2 and 1).  With
+     * three parallel axes the intersection of axes 5 and 6 fixes joint 1
+     * (subproblem 4), the orientation fixes joints 5 and 6 (subproblems 4
+     * and 1), and the planar arm gives joints 3, 2 and 4 (subproblems 3
+     * and 1).  Both give up to 8 solutions.  Every solution is verified with
+     * the forward kinematics and checked against the joint limits (joints
+     * with lower >= upper are unlimited).
+     *
+     * In a wrist singularity (axes 4 and 6 aligned, or axis 6 parallel to
+     * axes 2 to 4) only a sum of joints is determined: joint 4, resp. joint
+     * 6, keeps its value from q_init (0 for the overload enumerating all
+     * solutions).
+     *
+     * For other chains all methods return E_NOT_IMPLEMENTED.
+     *
+     * @ingroup KinematicFamily
+     */
+    class ChainIkSolverPos_SphericalWrist : public ChainIkSolverPos
+    {
+    public:
+        static const int E_OUT_OF_REACH = -100; //! No (verified) solution exists for the pose
+        static const int E_OUT_OF_LIMITS = -101; //! Solutions exist, but none within the joint limits
+
+        /**
+         * Constructor of the solver.
+         *
+         * @param chain the chain to calculate the inverse position for
+         * @param eps tolerance used to verify the solutions with the forward
+         * kinematics, and to classify the geometry of the chain. default: 1e-6
+         */
+        explicit ChainIkSolverPos_SphericalWrist(const Chain& chain, double eps=1e-6);
+        /// Shares the immutable \a chain with other solvers instead of copying it.
+        explicit ChainIkSolverPos_SphericalWrist(const ChainConstPtr& chain, double eps=1e-6);
+        ~ChainIkSolverPos_SphericalWrist();
+
+        /**
+         * Returns the solution closest to \a q_init.  Revolute joints are
+         * wrapped by multiples of 2*pi towards q_init, within the joint limits.
+         *
+         * @return E_NOERROR, E_OUT_OF_REACH, E_OUT_OF_LIMITS, E_SIZE_MISMATCH
+         * or E_NOT_IMPLEMENTED if the geometry of the chain is not supported.
+         */
+        virtual int CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out);
+
+        /**
+         * Enumerates all solutions for \a p_in.  Angles are wrapped into
+         * [-pi, pi) (in joint space, i.e. after dividing by the joint scale)
+         * and then shifted into the joint limits where possible.
+         *
+         * @param q_sols resized to the number of solutions found (at most 8).
+         * Memory is only allocated when q_sols has to grow.
+         * @return the same codes as the other CartToJnt.
+         */
+        int CartToJnt(const Frame& p_in, std::vector<JntArray>& q_sols);
+
+        /// True if the constructor recognized a supported geometry.
+        bool isSupported() const { return supported; }
+        /// True if the chain was recognized with three parallel axes instead of a spherical wrist.
+        bool hasParallelAxes() const { return parallel_axes; }
+
+        /// @copydoc KDL::SolverI::strError()
+        virtual const char* strError(const int error) const;
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+    private:
+        void analyse();
+        bool analyseSphericalWrist();
+        bool analyseParallelAxes();
+        // writes the joint angle increments (relative to q=0) of all branches and returns their number;
+        // ref provides the angles used where a joint is undetermined (singularities).
+        std::size_t solve(const Frame& p_in, const double ref[6], double theta[8][6]) const;
+        std::size_t solveSphericalWrist(const Frame& p_in, const double ref[6], double theta[8][6]) const;
+        std::size_t solveParallelAxes(const Frame& p_in, const double ref[6], double theta[8][6]) const;
+        // converts one branch into joint values close to ref, returns false when outside the limits.
+        bool toJoints(const double theta[6], const JntArray* ref, JntArray& q) const;
+
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
+        ChainFkSolverPos_recursive fksolver;
+        double eps;
+
+        bool supported;
+        bool parallel_axes;
+        // geometry at q=0, expressed in the base frame:
+        Vector axis[6];     // unit joint axes
+        Vector point[6];    // a point on every joint axis
+        double scale[6];    // |joint scale|, the rotation angle is scale*q
+        double lower[6];
+        double upper[6];
+        Vector wrist;       // intersection of the wrist axes (4 to 6, or 5 and 6 with three parallel axes)
+        Frame home_inv;     // inverse of the tip pose at q=0
+
+        JntArray q_tmp;
+        Frame f_tmp;
+    };
+
+}
+
+#endif
@@ -24,8 +24,14 @@
 namespace KDL
 {
     ChainIkSolverVel_pinv::ChainIkSolverVel_pinv(const Chain& _chain,double _eps,int _maxiter):
-        chain(_chain),
-        jnt2jac(chain),
+        ChainIkSolverVel_pinv(std::make_shared<const Chain>(_chain), _eps, _maxiter)
+    {
+    }
+
+    ChainIkSolverVel_pinv::ChainIkSolverVel_pinv(const ChainConstPtr& _chain,double _eps,int _maxiter):
+        chain_ptr(_chain),
+        chain(*chain_ptr),
+        jnt2jac(chain_ptr),
         nj(chain.getNrOfJoints()),
         jac(nj),
         svd(jac),
@@ -61,6 +67,7 @@ namespace KDL
 
     int ChainIkSolverVel_pinv::CartToJnt(const JntArray& q_in, const Twist& v_in, JntArray& qdot_out)
     {
+        KDL_SOLVER_TELEMETRY_SCOPE();
         if (nj != chain.getNrOfJoints())
             return (error = E_NOT_UP_TO_DATE);
 
@@ -55,6 +55,8 @@ namespace KDL
          *
          */
         explicit ChainIkSolverVel_pinv(const Chain& chain,double eps=0.00001,int maxiter=150);
+        /// Shares the immutable \a chain with other solvers instead of copying it.
+        explicit ChainIkSolverVel_pinv(const ChainConstPtr& chain,double eps=0.00001,int maxiter=150);
         ~ChainIkSolverVel_pinv();
 
         /**
@@ -98,7 +100,8 @@ namespace KDL
         /// @copydoc KDL::SolverI::updateInternalDataStructures
         virtual void updateInternalDataStructures();
     private:
-        const Chain chain;
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
         ChainJntToJacSolver jnt2jac;
         std::size_t nj;
         Jacobian jac;
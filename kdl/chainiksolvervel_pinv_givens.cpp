@@ -25,9 +25,15 @@
 namespace KDL
 {
     ChainIkSolverVel_pinv_givens::ChainIkSolverVel_pinv_givens(const Chain& _chain):
-        chain(_chain),
+        ChainIkSolverVel_pinv_givens(std::make_shared<const Chain>(_chain))
+    {
+    }
+
+    ChainIkSolverVel_pinv_givens::ChainIkSolverVel_pinv_givens(const ChainConstPtr& _chain):
+        chain_ptr(_chain),
+        chain(*chain_ptr),
         nj(chain.getNrOfJoints()),
-        jnt2jac(chain),
+        jnt2jac(chain_ptr),
         jac(nj),
         transpose(nj>6),toggle(true),
         m(max(6,nj)),
@@ -69,6 +75,7 @@ namespace KDL
 
     int ChainIkSolverVel_pinv_givens::CartToJnt(const JntArray& q_in, const Twist& v_in, JntArray& qdot_out)
     {
+        KDL_SOLVER_TELEMETRY_SCOPE();
         if (nj != chain.getNrOfJoints())
             return (error = E_NOT_UP_TO_DATE);
 
@@ -33,6 +33,8 @@ namespace KDL
          *
          */
         explicit ChainIkSolverVel_pinv_givens(const Chain& chain);
+        /// Shares the immutable \a chain with other solvers instead of copying it.
+        explicit ChainIkSolverVel_pinv_givens(const ChainConstPtr& chain);
         ~ChainIkSolverVel_pinv_givens();
 
         virtual int CartToJnt(const JntArray& q_in, const Twist& v_in, JntArray& qdot_out);
@@ -46,7 +48,8 @@ namespace KDL
         virtual void updateInternalDataStructures();
 
     private:
-        const Chain chain;
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
         std::size_t nj;
         ChainJntToJacSolver jnt2jac;
         Jacobian jac;
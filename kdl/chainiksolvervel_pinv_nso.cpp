@@ -25,8 +25,14 @@
 namespace KDL
 {
     ChainIkSolverVel_pinv_nso::ChainIkSolverVel_pinv_nso(const Chain& _chain, const JntArray& _opt_pos, const JntArray& _weights, double _eps, int _maxiter, double _alpha):
-        chain(_chain),
-        jnt2jac(chain),
+        ChainIkSolverVel_pinv_nso(std::make_shared<const Chain>(_chain), _opt_pos, _weights, _eps, _maxiter, _alpha)
+    {
+    }
+
+    ChainIkSolverVel_pinv_nso::ChainIkSolverVel_pinv_nso(const ChainConstPtr& _chain, const JntArray& _opt_pos, const JntArray& _weights, double _eps, int _maxiter, double _alpha):
+        chain_ptr(_chain),
+        chain(*chain_ptr),
+        jnt2jac(chain_ptr),
         nj(chain.getNrOfJoints()),
         jac(nj),
         U(MatrixXd::Zero(6,nj)),
@@ -45,8 +51,14 @@ namespace KDL
     }
 
     ChainIkSolverVel_pinv_nso::ChainIkSolverVel_pinv_nso(const Chain& _chain, double _eps, int _maxiter, double _alpha):
-        chain(_chain),
-        jnt2jac(chain),
+        ChainIkSolverVel_pinv_nso(std::make_shared<const Chain>(_chain), _eps, _maxiter, _alpha)
+    {
+    }
+
+    ChainIkSolverVel_pinv_nso::ChainIkSolverVel_pinv_nso(const ChainConstPtr& _chain, double _eps, int _maxiter, double _alpha):
+        chain_ptr(_chain),
+        chain(*chain_ptr),
+        jnt2jac(chain_ptr),
         nj(chain.getNrOfJoints()),
         jac(nj),
         U(MatrixXd::Zero(6,nj)),
@@ -83,6 +95,7 @@ namespace KDL
 
     int ChainIkSolverVel_pinv_nso::CartToJnt(const JntArray& q_in, const Twist& v_in, JntArray& qdot_out)
     {
+        KDL_SOLVER_TELEMETRY_SCOPE();
         if (nj != chain.getNrOfJoints())
             return (error = E_NOT_UP_TO_DATE);
 
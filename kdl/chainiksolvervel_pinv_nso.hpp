@@ -61,7 +61,11 @@ namespace KDL
          *
          */
         ChainIkSolverVel_pinv_nso(const Chain& chain, const JntArray& opt_pos, const JntArray& weights, double eps=0.00001,int maxiter=150, double alpha = 0.25);
+        /// Shares the immutable \a chain with other solvers instead of copying it.
+        ChainIkSolverVel_pinv_nso(const ChainConstPtr& chain, const JntArray& opt_pos, const JntArray& weights, double eps=0.00001,int maxiter=150, double alpha = 0.25);
         explicit ChainIkSolverVel_pinv_nso(const Chain& chain, double eps=0.00001,int maxiter=150, double alpha = 0.25);
+        /// Shares the immutable \a chain with other solvers instead of copying it.
+        explicit ChainIkSolverVel_pinv_nso(const ChainConstPtr& chain, double eps=0.00001,int maxiter=150, double alpha = 0.25);
         ~ChainIkSolverVel_pinv_nso();
 
         virtual int CartToJnt(const JntArray& q_in, const Twist& v_in, JntArray& qdot_out);
@@ -138,7 +142,8 @@ namespace KDL
         virtual void updateInternalDataStructures();
 
     private:
-        const Chain chain;
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
         ChainJntToJacSolver jnt2jac;
         std::size_t nj;
         Jacobian jac;
@@ -26,8 +26,14 @@ namespace KDL
 {
     
     ChainIkSolverVel_wdls::ChainIkSolverVel_wdls(const Chain& _chain,double _eps,int _maxiter):
-        chain(_chain),
-        jnt2jac(chain),
+        ChainIkSolverVel_wdls(std::make_shared<const Chain>(_chain), _eps, _maxiter)
+    {
+    }
+
+    ChainIkSolverVel_wdls::ChainIkSolverVel_wdls(const ChainConstPtr& _chain,double _eps,int _maxiter):
+        chain_ptr(_chain),
+        chain(*chain_ptr),
+        jnt2jac(chain_ptr),
         nj(chain.getNrOfJoints()),
         jac(nj),
         U(MatrixXd::Zero(6,nj)),
@@ -115,6 +121,7 @@ namespace KDL
 
     int ChainIkSolverVel_wdls::CartToJnt(const JntArray& q_in, const Twist& v_in, JntArray& qdot_out)
     {
+        KDL_SOLVER_TELEMETRY_SCOPE();
         if(nj != chain.getNrOfJoints())
             return (error = E_NOT_UP_TO_DATE);
 
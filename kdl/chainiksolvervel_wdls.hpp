@@ -79,6 +79,8 @@ namespace KDL
          */
 
         explicit ChainIkSolverVel_wdls(const Chain& chain,double eps=0.00001,int maxiter=150);
+        /// Shares the immutable \a chain with other solvers instead of copying it.
+        explicit ChainIkSolverVel_wdls(const ChainConstPtr& chain,double eps=0.00001,int maxiter=150);
         //=ublas::identity_matrix<double>
         ~ChainIkSolverVel_wdls();
 
@@ -216,7 +218,8 @@ namespace KDL
         virtual void updateInternalDataStructures();
 
     private:
-        const Chain chain;
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
         ChainJntToJacSolver jnt2jac;
         std::size_t nj;
         Jacobian jac;
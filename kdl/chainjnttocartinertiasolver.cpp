@@ -0,0 +1,357 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainjnttocartinertiasolver.hpp"
+
+namespace KDL
+{
+    namespace
+    {
+        typedef Eigen::Matrix<double,6,1> Vector6d;
+        typedef Eigen::Map<const Eigen::Matrix<double,3,3,Eigen::RowMajor> > RotationMap;
+
+        //6x6 matrix of Frame::Inverse(Twist), twists ordered (vel; rot).  Its
+        //transpose is the matrix of Frame*Wrench, wrenches ordered (force; torque).
+        void inverseMotionMatrix(const Frame& F, ChainJntToCartInertiaSolver::Matrix6d& M)
+        {
+            RotationMap R(F.M.data);
+            Eigen::Matrix3d p_cross;
+            p_cross << 0,-F.p(2),F.p(1), F.p(2),0,-F.p(0), -F.p(1),F.p(0),0;
+            M.topLeftCorner<3,3>()=R.transpose();
+            M.topRightCorner<3,3>().noalias()=-R.transpose()*p_cross;
+            M.bottomLeftCorner<3,3>().setZero();
+            M.bottomRightCorner<3,3>()=R.transpose();
+        }
+
+        Vector6d toVector(const Twist& t)
+        {
+            Vector6d v;
+            v << t.vel.x(), t.vel.y(), t.vel.z(), t.rot.x(), t.rot.y(), t.rot.z();
+            return v;
+        }
+
+        Vector6d toVector(const Wrench& w)
+        {
+            Vector6d v;
+            v << w.force.x(), w.force.y(), w.force.z(), w.torque.x(), w.torque.y(), w.torque.z();
+            return v;
+        }
+    }
+
+    ChainJntToCartInertiaSolver::ChainJntToCartInertiaSolver(const Chain& _chain, double _eps):
+        ChainJntToCartInertiaSolver(std::make_shared<const Chain>(_chain), _eps)
+    {
+    }
+
+    ChainJntToCartInertiaSolver::ChainJntToCartInertiaSolver(const ChainConstPtr& _chain, double _eps):
+        chain_ptr(_chain), chain(*chain_ptr), nj(chain.getNrOfJoints()), ns(chain.getNrOfSegments()), eps(_eps),
+        X(ns), T(ns), S(ns), IA(ns), U(ns), D(ns), Omega(ns), Q(nj,6)
+    {
+    }
+
+    ChainJntToCartInertiaSolver::~ChainJntToCartInertiaSolver()
+    {
+    }
+
+    void ChainJntToCartInertiaSolver::updateInternalDataStructures()
+    {
+        nj = chain.getNrOfJoints();
+        ns = chain.getNrOfSegments();
+        X.resize(ns);
+        T.resize(ns);
+        S.resize(ns);
+        IA.resize(ns);
+        U.resize(ns);
+        D.resize(ns);
+        Omega.resize(ns);
+        Q.resize(nj,6);
+    }
+
+    int ChainJntToCartInertiaSolver::JntToCartInertia(const JntArray& q, Matrix6d& lambda, int seg_nr)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        return (error = cartInertia(q, lambda, seg_nr));
+    }
+
+    int ChainJntToCartInertiaSolver::JntToCartInertia(const JntArray& q, Matrix6d& lambda, Eigen::MatrixXd& jac_bar, int seg_nr)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        if((std::size_t)jac_bar.rows()!=nj || jac_bar.cols()!=6)
+            return (error = E_SIZE_MISMATCH);
+        error = cartInertia(q, lambda, seg_nr);
+        if(error < E_NOERROR)
+            return error;
+        const int rc = error;
+
+        //H^-1 J^T = Q R^T, with R the rotation of the tip on both the force and the torque
+        std::size_t segmentNr;
+        segmentNumber(seg_nr, segmentNr);
+        unitWrenchResponse(segmentNr);
+        Matrix6d RtLambda;
+        if(segmentNr>0){
+            RotationMap R(T[segmentNr-1].M.data);
+            RtLambda.topRows<3>().noalias()=R.transpose()*lambda.topRows<3>();
+            RtLambda.bottomRows<3>().noalias()=R.transpose()*lambda.bottomRows<3>();
+        }else
+            RtLambda=lambda;
+        jac_bar.noalias()=Q*RtLambda;
+        return (error = rc);
+    }
+
+    int ChainJntToCartInertiaSolver::JntToCartInertia(const JntArray& q, const std::vector<int>& seg_nrs, Matrix6dVector& lambdas)
+    {
+        if(lambdas.size()!=seg_nrs.size())
+            return (error = E_SIZE_MISMATCH);
+        std::size_t segmentNr;
+        for(std::size_t k=0;k<seg_nrs.size();k++){
+            error = segmentNumber(seg_nrs[k], segmentNr);
+            if(error != E_NOERROR)
+                return error;
+        }
+        error = sweep(q);
+        if(error != E_NOERROR)
+            return error;
+
+        int rc = E_NOERROR;
+        Matrix6d lambda_inv;
+        for(std::size_t k=0;k<seg_nrs.size();k++){
+            segmentNumber(seg_nrs[k], segmentNr);
+            inverseCartInertia(segmentNr, lambda_inv);
+            if(invert(lambda_inv, lambdas[k]) != E_NOERROR)
+                rc = E_DEGRADED;
+        }
+        return (error = rc);
+    }
+
+    int ChainJntToCartInertiaSolver::JntToInverseCartInertia(const JntArray& q, Matrix6d& lambda_inv, int seg_nr)
+    {
+        std::size_t segmentNr;
+        error = segmentNumber(seg_nr, segmentNr);
+        if(error != E_NOERROR)
+            return error;
+        error = sweep(q);
+        if(error != E_NOERROR)
+            return error;
+
+        inverseCartInertia(segmentNr, lambda_inv);
+        return (error = E_NOERROR);
+    }
+
+    int ChainJntToCartInertiaSolver::JntToInverseCartInertia(const JntArray& q, const std::vector<int>& seg_nrs, Matrix6dVector& lambda_invs)
+    {
+        if(lambda_invs.size()!=seg_nrs.size())
+            return (error = E_SIZE_MISMATCH);
+        std::size_t segmentNr;
+        for(std::size_t k=0;k<seg_nrs.size();k++){
+            error = segmentNumber(seg_nrs[k], segmentNr);
+            if(error != E_NOERROR)
+                return error;
+        }
+        error = sweep(q);
+        if(error != E_NOERROR)
+            return error;
+
+        for(std::size_t k=0;k<seg_nrs.size();k++){
+            segmentNumber(seg_nrs[k], segmentNr);
+            inverseCartInertia(segmentNr, lambda_invs[k]);
+        }
+        return (error = E_NOERROR);
+    }
+
+    int ChainJntToCartInertiaSolver::cartInertia(const JntArray& q, Matrix6d& lambda, int seg_nr)
+    {
+        std::size_t segmentNr;
+        int rc = segmentNumber(seg_nr, segmentNr);
+        if(rc != E_NOERROR)
+            return rc;
+        rc = sweep(q);
+        if(rc != E_NOERROR)
+            return rc;
+
+        Matrix6d lambda_inv;
+        inverseCartInertia(segmentNr, lambda_inv);
+        return invert(lambda_inv, lambda);
+    }
+
+    int ChainJntToCartInertiaSolver::segmentNumber(int seg_nr, std::size_t& segmentNr) const
+    {
+        if(seg_nr<0)
+            segmentNr=ns;
+        else
+            segmentNr=seg_nr;
+        if(segmentNr>ns)
+            return E_OUT_OF_RANGE;
+        return E_NOERROR;
+    }
+
+    int ChainJntToCartInertiaSolver::sweep(const JntArray& q)
+    {
+        if(nj != chain.getNrOfJoints() || ns != chain.getNrOfSegments())
+            return E_NOT_UP_TO_DATE;
+        if(q.rows()!=nj)
+            return E_SIZE_MISMATCH;
+
+        //Sweep from root to leaf: poses and rigid body inertias
+        std::size_t j=0;
+        for(std::size_t i=0;i<ns;i++){
+            const Segment& segment=chain.getSegment(i);
+            double q_=0.0;
+            if(segment.getJoint().getType()!=Joint::Fixed){
+                q_=q(j);
+                j++;
+            }
+            X[i]=segment.pose(q_);
+            T[i]= i==0 ? X[i] : T[i-1]*X[i];
+            S[i]=X[i].M.Inverse(segment.twist(q_,1.0));
+            IA[i]=segment.getInertia();
+        }
+
+        //Sweep from leaf to root: articulated body inertias, see ChainFdSolver_ABA
+        for(int i=ns-1;i>=0;i--){
+            const Joint& joint=chain.getSegment(i).getJoint();
+            const bool moving=joint.getType()!=Joint::Fixed;
+            if(moving){
+                U[i]=IA[i]*S[i];
+                D[i]=dot(S[i],U[i])+joint.getInertia();
+                if(!(D[i]>0))
+                    return E_UNDEFINED;
+            }
+            if(i!=0){
+                ArticulatedBodyInertia Ia=IA[i];
+                if(moving){
+                    Eigen::Map<const Eigen::Vector3d> Uf(U[i].force.data);
+                    Eigen::Map<const Eigen::Vector3d> Ut(U[i].torque.data);
+                    const double Dinv=1.0/D[i];
+                    Ia.M.noalias()-=Dinv*Uf*Uf.transpose();
+                    Ia.H.noalias()-=Dinv*Ut*Uf.transpose();
+                    Ia.I.noalias()-=Dinv*Ut*Ut.transpose();
+                }
+                IA[i-1]=IA[i-1]+X[i]*Ia;
+            }
+        }
+
+        //Sweep from root to leaf: the inverse operational space inertia of a
+        //segment is the one of its parent seen through the joint,
+        //P X Omega X^T P^T with P = 1 - S U^T/D, plus S S^T/D
+        Matrix6d M;
+        for(std::size_t i=0;i<ns;i++){
+            if(i==0)
+                Omega[i].setZero();
+            else{
+                inverseMotionMatrix(X[i], M);
+                Omega[i].noalias()=M*Omega[i-1]*M.transpose();
+            }
+            if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed){
+                const Vector6d s=toVector(S[i]);
+                const Vector6d u=toVector(U[i]);
+                const Vector6d w=Omega[i]*u;
+                const double Dinv=1.0/D[i];
+                Omega[i].noalias()-=Dinv*(s*w.transpose()+w*s.transpose());
+                Omega[i].noalias()+=(Dinv+Dinv*Dinv*u.dot(w))*s*s.transpose();
+            }
+        }
+        return E_NOERROR;
+    }
+
+    void ChainJntToCartInertiaSolver::inverseCartInertia(std::size_t segmentNr, Matrix6d& lambda_inv) const
+    {
+        if(segmentNr==0){
+            lambda_inv.setZero();
+            return;
+        }
+        //from segment to base coordinates, the reference point stays at the tip
+        RotationMap R(T[segmentNr-1].M.data);
+        const Matrix6d& Om=Omega[segmentNr-1];
+        lambda_inv.topLeftCorner<3,3>().noalias()=R*Om.topLeftCorner<3,3>()*R.transpose();
+        lambda_inv.topRightCorner<3,3>().noalias()=R*Om.topRightCorner<3,3>()*R.transpose();
+        lambda_inv.bottomLeftCorner<3,3>()=lambda_inv.topRightCorner<3,3>().transpose();
+        lambda_inv.bottomRightCorner<3,3>().noalias()=R*Om.bottomRightCorner<3,3>()*R.transpose();
+    }
+
+    int ChainJntToCartInertiaSolver::invert(const Matrix6d& lambda_inv, Matrix6d& lambda)
+    {
+        //The Cholesky factorization is enough if the smallest eigenvalue,
+        //at least 1/|lambda|, is above eps
+        llt.compute(lambda_inv);
+        if(llt.info()==Eigen::Success){
+            lambda.setIdentity();
+            llt.solveInPlace(lambda);
+            if(lambda.norm()*eps<1.0)
+                return E_NOERROR;
+        }
+
+        eig.compute(lambda_inv);
+        if(eig.info()!=Eigen::Success)
+            return E_UNDEFINED;
+        Vector6d ev;
+        int rc=E_NOERROR;
+        for(int k=0;k<6;k++){
+            if(eig.eigenvalues()(k)>eps)
+                ev(k)=1.0/eig.eigenvalues()(k);
+            else{
+                ev(k)=0.0;
+                rc=E_DEGRADED;
+            }
+        }
+        lambda.noalias()=eig.eigenvectors()*ev.asDiagonal()*eig.eigenvectors().transpose();
+        return rc;
+    }
+
+    void ChainJntToCartInertiaSolver::unitWrenchResponse(std::size_t segmentNr)
+    {
+        //Column k of Q holds the joint accelerations caused by unit wrench k
+        //at the tip, in tip coordinates, without velocity and gravity.  The
+        //six wrenches are swept together, as the bias forces of ChainFdSolver_ABA.
+        Matrix6d M;
+        std::size_t j=0;
+        for(std::size_t i=0;i<segmentNr;i++)
+            if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed)
+                j++;
+
+        //Sweep from the tip to the root: wrenches on the segments, Q holds
+        //the joint torques S^T B that they cause until the next sweep
+        Matrix6d B=Matrix6d::Identity();
+        for(int i=segmentNr-1;i>=0;i--){
+            if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed){
+                --j;
+                Q.row(j).noalias()=toVector(S[i]).transpose()*B;
+                B.noalias()-=(1.0/D[i])*toVector(U[i])*Q.row(j);
+            }
+            if(i!=0){
+                inverseMotionMatrix(X[i], M);
+                B=M.transpose()*B;
+            }
+        }
+
+        //Sweep from root to leaf: accelerations
+        Matrix6d A=Matrix6d::Zero();
+        j=0;
+        for(std::size_t i=0;i<ns;i++){
+            if(i!=0){
+                inverseMotionMatrix(X[i], M);
+                A=M*A;
+            }
+            if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed){
+                if(i>=segmentNr)
+                    Q.row(j).setZero();
+                Q.row(j).noalias()-=toVector(U[i]).transpose()*A;
+                Q.row(j)/=D[i];
+                A.noalias()+=toVector(S[i])*Q.row(j);
+                j++;
+            }
+        }
+    }
+}
@@ -0,0 +1,146 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_CHAINJNTTOCARTINERTIASOLVER_HPP
+#define KDL_CHAINJNTTOCARTINERTIASOLVER_HPP
+
+#include "chain.hpp"
+#include "jntarray.hpp"
+#include "articulatedbodyinertia.hpp"
+#include "solveri.hpp"
+
+#include <Eigen/Core>
+#include <Eigen/Cholesky>
+#include <Eigen/Eigenvalues>
+
+namespace KDL
+{
+    /**
+     * \brief Computes the operational space inertia
+     * \f$ \Lambda = (J H^{-1} J^T)^{-1} \f$ of one or more tips of a chain,
+     * and its inverse, without forming H or J.
+     *
+     * After the articulated-body inertias (as in ChainFdSolver_ABA) one
+     * sweep from the root to the leaf gives the inverse operational space
+     * inertia of every segment, so the cost is O(n) for any number of tips.
+     * The dynamically consistent generalized inverse
+     * \f$ \bar J = H^{-1} J^T \Lambda \f$ costs another O(n) per tip.
+     *
+     * J is the Jacobian of ChainJntToJacSolver: expressed in the base frame
+     * of the chain, with reference point at the tip, rows ordered
+     * (vel; rot).  Wrenches are ordered (force; torque).  The joint rotor
+     * inertias are included, as in ChainDynParam::JntToMass.
+     *
+     * @ingroup KinematicFamily
+     */
+    class ChainJntToCartInertiaSolver : public SolverI
+    {
+    public:
+        typedef Eigen::Matrix<double,6,6> Matrix6d;
+        typedef std::vector<Matrix6d, Eigen::aligned_allocator<Matrix6d> > Matrix6dVector;
+
+        /**
+         * @param chain the chain to calculate the inertias for, an internal copy will be made
+         * @param eps eigenvalues of the inverse inertia below this value
+         * are treated as zero when inverting, see JntToCartInertia
+         */
+        explicit ChainJntToCartInertiaSolver(const Chain& chain, double eps=1e-9);
+        /// Shares the immutable \a chain with other solvers instead of copying it.
+        explicit ChainJntToCartInertiaSolver(const ChainConstPtr& chain, double eps=1e-9);
+        virtual ~ChainJntToCartInertiaSolver();
+
+        /**
+         * Calculates the operational space inertia at a tip.
+         *
+         * Where the tip cannot move in some direction (fewer than six
+         * joints, or a singular configuration) \f$ J H^{-1} J^T \f$ is
+         * not invertible; the pseudo-inverse is returned instead, with the
+         * eigenvalues below eps treated as zero.
+         *
+         * @param q joint positions
+         * @param lambda output 6x6 operational space inertia
+         * @param seg_nr the tip is the end of this many segments, -1 for the whole chain
+         * @return E_DEGRADED if the pseudo-inverse is returned,
+         * E_OUT_OF_RANGE if \a seg_nr is larger than the number of segments,
+         * E_UNDEFINED if a joint moves no mass
+         */
+        int JntToCartInertia(const JntArray& q, Matrix6d& lambda, int seg_nr=-1);
+
+        /**
+         * Same as above, and also calculates the dynamically consistent
+         * generalized inverse of the Jacobian.
+         *
+         * @param jac_bar output nj x 6 matrix \f$ H^{-1} J^T \Lambda \f$
+         */
+        int JntToCartInertia(const JntArray& q, Matrix6d& lambda, Eigen::MatrixXd& jac_bar, int seg_nr=-1);
+
+        /**
+         * Calculates the operational space inertias of several tips, sharing
+         * the sweeps over the chain.
+         *
+         * @param q joint positions
+         * @param seg_nrs the tips, as the seg_nr of the single tip version
+         * @param lambdas output inertias, same size as \a seg_nrs
+         * @return E_DEGRADED if any of the pseudo-inverses is returned
+         */
+        int JntToCartInertia(const JntArray& q, const std::vector<int>& seg_nrs, Matrix6dVector& lambdas);
+
+        /**
+         * Calculates the inverse operational space inertia
+         * \f$ J H^{-1} J^T \f$ at a tip, which always exists.
+         *
+         * @param q joint positions
+         * @param lambda_inv output 6x6 inverse operational space inertia
+         * @param seg_nr the tip is the end of this many segments, -1 for the whole chain
+         * @return E_OUT_OF_RANGE if \a seg_nr is larger than the number of segments
+         */
+        int JntToInverseCartInertia(const JntArray& q, Matrix6d& lambda_inv, int seg_nr=-1);
+
+        /**
+         * Calculates the inverse operational space inertias of several tips.
+         */
+        int JntToInverseCartInertia(const JntArray& q, const std::vector<int>& seg_nrs, Matrix6dVector& lambda_invs);
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+    private:
+        int cartInertia(const JntArray& q, Matrix6d& lambda, int seg_nr);
+        int sweep(const JntArray& q);
+        int segmentNumber(int seg_nr, std::size_t& segmentNr) const;
+        void inverseCartInertia(std::size_t segmentNr, Matrix6d& lambda_inv) const;
+        int invert(const Matrix6d& lambda_inv, Matrix6d& lambda);
+        void unitWrenchResponse(std::size_t segmentNr);
+
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
+        std::size_t nj;
+        std::size_t ns;
+        double eps;
+        std::vector<Frame> X;
+        std::vector<Frame> T;   // pose of the segments with respect to the base
+        std::vector<Twist> S;
+        std::vector<ArticulatedBodyInertia> IA;
+        std::vector<Wrench> U;
+        std::vector<double> D;
+        Matrix6dVector Omega;   // inverse operational space inertia, in segment coordinates
+        Eigen::Matrix<double,Eigen::Dynamic,6> Q;   // joint accelerations per unit tip wrench
+        Eigen::LLT<Matrix6d> llt;
+        Eigen::SelfAdjointEigenSolver<Matrix6d> eig;
+    };
+}
+
+#endif
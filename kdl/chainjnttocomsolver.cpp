@@ -0,0 +1,117 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainjnttocomsolver.hpp"
+
+namespace KDL
+{
+    ChainJntToComSolver::ChainJntToComSolver(const Chain& _chain):
+        ChainJntToComSolver(std::make_shared<const Chain>(_chain))
+    {
+    }
+
+    ChainJntToComSolver::ChainJntToComSolver(const ChainConstPtr& _chain):
+        chain_ptr(_chain), chain(*chain_ptr), nj(chain.getNrOfJoints()), ns(chain.getNrOfSegments()),
+        I_base(ns), S_base(ns)
+    {
+    }
+
+    ChainJntToComSolver::~ChainJntToComSolver()
+    {
+    }
+
+    void ChainJntToComSolver::updateInternalDataStructures()
+    {
+        nj = chain.getNrOfJoints();
+        ns = chain.getNrOfSegments();
+        I_base.resize(ns);
+        S_base.resize(ns);
+    }
+
+    int ChainJntToComSolver::JntToCoM(const JntArray& q, double& mass, Vector& com)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        if(nj != chain.getNrOfJoints() || ns != chain.getNrOfSegments())
+            return (error = E_NOT_UP_TO_DATE);
+        if(q.rows()!=nj)
+            return (error = E_SIZE_MISMATCH);
+
+        Frame T=Frame::Identity();
+        RigidBodyInertia I_total;
+        std::size_t j=0;
+        for(std::size_t i=0;i<ns;i++){
+            const Segment& segment=chain.getSegment(i);
+            if(segment.getJoint().getType()!=Joint::Fixed)
+                T=T*segment.pose(q(j++));
+            else
+                T=T*segment.pose(0.0);
+            I_total=I_total+T*segment.getInertia();
+        }
+        mass=I_total.getMass();
+        com=I_total.getCOG();
+        return (error = E_NOERROR);
+    }
+
+    int ChainJntToComSolver::JntToCentroidal(const JntArray& q, double& mass, Vector& com, Eigen::MatrixXd& com_jac, Eigen::MatrixXd& cmm)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        if(nj != chain.getNrOfJoints() || ns != chain.getNrOfSegments())
+            return (error = E_NOT_UP_TO_DATE);
+        if(q.rows()!=nj || com_jac.rows()!=3 || (std::size_t)com_jac.cols()!=nj ||
+           cmm.rows()!=6 || (std::size_t)cmm.cols()!=nj)
+            return (error = E_SIZE_MISMATCH);
+
+        //Sweep from root to leaf: inertias and joint twists in the base
+        //frame, with reference point at the base origin
+        Frame T=Frame::Identity();
+        std::size_t j=0;
+        for(std::size_t i=0;i<ns;i++){
+            const Segment& segment=chain.getSegment(i);
+            double q_=0.0;
+            if(segment.getJoint().getType()!=Joint::Fixed)
+                q_=q(j++);
+            const Frame T_parent=T;
+            T=T*segment.pose(q_);
+            S_base[i]=(T_parent.M*segment.twist(q_,1.0)).RefPoint(-T.p);
+            I_base[i]=T*segment.getInertia();
+        }
+
+        //Sweep from leaf to root: the momentum of the subchain beyond a
+        //joint is the composite inertia times the unit twist of the joint
+        RigidBodyInertia I_composite;
+        for(std::size_t i=ns;i-->0;){
+            I_composite=I_composite+I_base[i];
+            if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed){
+                const Wrench h=I_composite*S_base[i];
+                cmm.col(--j) << Eigen::Vector3d::Map(h.force.data), Eigen::Vector3d::Map(h.torque.data);
+            }
+        }
+
+        //Angular momentum about the center of mass
+        mass=I_composite.getMass();
+        com=I_composite.getCOG();
+        for(std::size_t k=0;k<nj;k++){
+            const Vector p(cmm(0,k),cmm(1,k),cmm(2,k));
+            const Vector p_x_com=p*com;
+            cmm.col(k).tail<3>()+=Eigen::Vector3d::Map(p_x_com.data);
+        }
+        if(mass>0)
+            com_jac=cmm.topRows<3>()/mass;
+        else
+            com_jac.setZero();
+        return (error = E_NOERROR);
+    }
+}
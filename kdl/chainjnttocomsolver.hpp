@@ -0,0 +1,93 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_CHAINJNTTOCOMSOLVER_HPP
+#define KDL_CHAINJNTTOCOMSOLVER_HPP
+
+#include "chain.hpp"
+#include "jntarray.hpp"
+#include "solveri.hpp"
+
+#include <Eigen/Core>
+
+namespace KDL
+{
+    /**
+     * \brief Computes the center of mass of a chain, its Jacobian and the
+     * centroidal momentum matrix.
+     *
+     * The inertias of the segments are transformed to the base frame while
+     * the poses are propagated from the root to the leaf, and summed into
+     * the composite inertias of the subchains from the leaf to the root.
+     * The momentum of the subchain beyond a joint moving at unit velocity
+     * is a column of the centroidal momentum matrix.
+     *
+     * Everything is expressed in the base frame of the chain.  The
+     * centroidal momentum matrix A gives the momentum
+     * \f$ A \dot q \f$ ordered (linear; angular), with the angular momentum
+     * about the center of mass.  The center of mass Jacobian is the
+     * linear part divided by the total mass.  See TreeJntToComSolver for
+     * trees.
+     *
+     * @ingroup KinematicFamily
+     */
+    class ChainJntToComSolver : public SolverI
+    {
+    public:
+        /**
+         * @param chain the chain to calculate the center of mass for, an internal copy will be made
+         */
+        explicit ChainJntToComSolver(const Chain& chain);
+        /// Shares the immutable \a chain with other solvers instead of copying it.
+        explicit ChainJntToComSolver(const ChainConstPtr& chain);
+        virtual ~ChainJntToComSolver();
+
+        /**
+         * Calculates the total mass and the center of mass.
+         *
+         * @param q joint positions
+         * @param mass output total mass
+         * @param com output center of mass, zero if the chain has no mass
+         */
+        int JntToCoM(const JntArray& q, double& mass, Vector& com);
+
+        /**
+         * Calculates the total mass, the center of mass, its Jacobian
+         * and the centroidal momentum matrix.
+         *
+         * @param q joint positions
+         * @param mass output total mass
+         * @param com output center of mass
+         * @param com_jac output 3 x nj center of mass Jacobian, zero if
+         * the chain has no mass
+         * @param cmm output 6 x nj centroidal momentum matrix
+         */
+        int JntToCentroidal(const JntArray& q, double& mass, Vector& com, Eigen::MatrixXd& com_jac, Eigen::MatrixXd& cmm);
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+    private:
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
+        std::size_t nj;
+        std::size_t ns;
+        std::vector<RigidBodyInertia> I_base;   // inertia of a segment in the base frame
+        std::vector<Twist> S_base;              // unit twist of a joint in the base frame
+    };
+}
+
+#endif
@@ -0,0 +1,128 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainjnttogravitysolver.hpp"
+
+#include <algorithm>
+
+namespace KDL
+{
+    ChainJntToGravitySolver::ThreadState::ThreadState(std::size_t ns) :
+        X(ns), g(ns)
+    {
+    }
+
+    void ChainJntToGravitySolver::ThreadState::resize(std::size_t ns)
+    {
+        X.resize(ns);
+        g.resize(ns);
+    }
+
+    ChainJntToGravitySolver::ChainJntToGravitySolver(const Chain& _chain, Vector _grav, std::size_t _nr_of_threads,
+                                                     std::size_t _block_size) :
+        ChainJntToGravitySolver(std::make_shared<const Chain>(_chain), _grav, _nr_of_threads, _block_size)
+    {
+    }
+
+    ChainJntToGravitySolver::ChainJntToGravitySolver(const ChainConstPtr& _chain, Vector _grav, std::size_t _nr_of_threads,
+                                                     std::size_t _block_size) :
+        chain_ptr(_chain), chain(*chain_ptr), nj(0), ns(0),
+        grav(_grav),
+        pool(_nr_of_threads),
+        threads(pool.size(), ThreadState(0)),
+        block_size(_block_size > 0 ? _block_size : 1)
+    {
+        updateInternalDataStructures();
+    }
+
+    ChainJntToGravitySolver::~ChainJntToGravitySolver()
+    {
+    }
+
+    void ChainJntToGravitySolver::updateInternalDataStructures()
+    {
+        nj = chain.getNrOfJoints();
+        ns = chain.getNrOfSegments();
+        //The unit twist of a joint does not depend on q in the segment frame
+        S.resize(ns);
+        M.resize(ns);
+        h.resize(ns);
+        double mass=0.0;
+        for(std::size_t i=ns;i-->0;){
+            const Segment& segment=chain.getSegment(i);
+            S[i]=segment.pose(0.0).M.Inverse(segment.twist(0.0,1.0));
+            const RigidBodyInertia& I=segment.getInertia();
+            mass+=I.getMass();
+            M[i]=mass;
+            h[i]=I.getMass()*I.getCOG();
+        }
+        for(std::size_t t=0;t<threads.size();t++)
+            threads[t].resize(ns);
+    }
+
+    int ChainJntToGravitySolver::JntToGravity(const JntArray& q, JntArray& gravity)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        if(nj != chain.getNrOfJoints() || ns != chain.getNrOfSegments())
+            return (error = E_NOT_UP_TO_DATE);
+        if(q.rows()!=nj || gravity.rows()!=nj)
+            return (error = E_SIZE_MISMATCH);
+        gravityTorques(q.data.data(), gravity.data.data(), threads[0]);
+        return (error = E_NOERROR);
+    }
+
+    int ChainJntToGravitySolver::JntToGravity(const Eigen::MatrixXd& q, Eigen::MatrixXd& gravity)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        if(nj != chain.getNrOfJoints() || ns != chain.getNrOfSegments())
+            return (error = E_NOT_UP_TO_DATE);
+        if((std::size_t)q.rows()!=nj || gravity.rows()!=q.rows() || gravity.cols()!=q.cols())
+            return (error = E_SIZE_MISMATCH);
+
+        const std::size_t n = q.cols();
+        pool.parallel_for((n + block_size - 1) / block_size, [&](std::size_t block, std::size_t t) {
+            const std::size_t end = std::min(n, (block + 1) * block_size);
+            for(std::size_t k = block * block_size; k < end; ++k)
+                gravityTorques(q.col(k).data(), gravity.col(k).data(), threads[t]);
+        });
+        return (error = E_NOERROR);
+    }
+
+    void ChainJntToGravitySolver::gravityTorques(const double* q, double* gravity, ThreadState& state) const
+    {
+        std::vector<Frame>& X=state.X;
+        std::vector<Vector>& g=state.g;
+        std::size_t j=0;
+
+        //Sweep from root to leaf: gravity in the segment frames
+        for(std::size_t i=0;i<ns;i++){
+            const Segment& segment=chain.getSegment(i);
+            X[i]=segment.pose(segment.getJoint().getType()!=Joint::Fixed ? q[j++] : 0.0);
+            g[i]=X[i].M.Inverse(i==0 ? grav : g[i-1]);
+        }
+
+        //Sweep from leaf to root: first moment of mass of the subchain in
+        //the segment frame, the weight -M g acts at h/M
+        Vector h_sub=Vector::Zero();
+        for(std::size_t i=ns;i-->0;){
+            h_sub+=h[i];
+            if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed)
+                gravity[--j]=-M[i]*dot(S[i].vel,g[i])+dot(S[i].rot,g[i]*h_sub);
+            if(i!=0)
+                h_sub=X[i].M*h_sub+M[i]*X[i].p;
+        }
+    }
+}
@@ -0,0 +1,116 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_CHAINJNTTOGRAVITYSOLVER_HPP
+#define KDL_CHAINJNTTOGRAVITYSOLVER_HPP
+
+#include "chain.hpp"
+#include "jntarray.hpp"
+#include "solveri.hpp"
+#include "utilities/thread_pool.hpp"
+
+#include <Eigen/Core>
+#include <vector>
+
+namespace KDL
+{
+    /**
+     * \brief Computes the joint torques that compensate gravity.
+     *
+     * The result is the same as ChainIdSolver_RNE with zero velocities,
+     * accelerations and external forces, but the only forces are the
+     * weights of the segments.  A subchain beyond a joint weighs its total
+     * mass M and its weight acts on the joint through its first moment
+     * of mass h (mass times center of mass), so the torque of the joint
+     * follows from the gravity vector g in the segment frame as
+     * \f$ \tau = S_{lin} \cdot (-M g) + S_{rot} \cdot (g \times h) \f$.
+     *
+     * The masses of the subchains, the first moments of the segments and
+     * the unit twists of the joints do not depend on q and are computed
+     * when the chain is set.  A call then rotates g from the root to the
+     * leaf, and h from the leaf to the root, with one cross product per
+     * joint.
+     *
+     * The matrix version computes many configurations, split into blocks
+     * of consecutive columns that the threads of a ThreadPool take as they
+     * become idle.  Every thread has its own workspace: the solver does not
+     * allocate memory.
+     *
+     * @ingroup KinematicFamily
+     */
+    class ChainJntToGravitySolver : public SolverI
+    {
+    public:
+        /**
+         * @param chain the chain to calculate the gravity torques for, an internal copy will be made
+         * @param grav the gravity vector
+         * @param nr_of_threads number of threads used by the matrix
+         *        version, including the calling thread.  0 selects the
+         *        number of hardware threads.
+         * @param block_size number of consecutive columns handed to a thread at once.
+         */
+        ChainJntToGravitySolver(const Chain& chain, Vector grav, std::size_t nr_of_threads=1, std::size_t block_size=64);
+        /// Shares the immutable \a chain with other solvers instead of copying it.
+        ChainJntToGravitySolver(const ChainConstPtr& chain, Vector grav, std::size_t nr_of_threads=1, std::size_t block_size=64);
+        ~ChainJntToGravitySolver();
+
+        /**
+         * Calculates the gravity torques.
+         *
+         * @param q joint positions
+         * @param gravity output joint torques
+         */
+        int JntToGravity(const JntArray& q, JntArray& gravity);
+
+        /**
+         * Calculates the gravity torques of many configurations.
+         *
+         * @param q joint positions, nj x N
+         * @param gravity receives the joint torques, nj x N (not resized)
+         * @return E_SIZE_MISMATCH if the sizes of the arguments do not match
+         */
+        int JntToGravity(const Eigen::MatrixXd& q, Eigen::MatrixXd& gravity);
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+    private:
+        // workspace of one thread
+        struct ThreadState
+        {
+            explicit ThreadState(std::size_t ns);
+            void resize(std::size_t ns);
+            std::vector<Frame> X;
+            std::vector<Vector> g;
+        };
+
+        void gravityTorques(const double* q, double* gravity, ThreadState& state) const;
+
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
+        std::size_t nj;
+        std::size_t ns;
+        Vector grav;
+        std::vector<Twist> S;           // unit twist of a joint in the segment frame
+        std::vector<double> M;          // mass of the subchain from a segment to the leaf
+        std::vector<Vector> h;          // first moment of mass of a segment in its frame
+        ThreadPool pool;
+        std::vector<ThreadState> threads;
+        std::size_t block_size;
+    };
+}
+
+#endif
@@ -0,0 +1,211 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainjnttoinversemasssolver.hpp"
+
+namespace KDL
+{
+    ChainJntToInverseMassSolver::ChainJntToInverseMassSolver(const Chain& _chain):
+        ChainJntToInverseMassSolver(std::make_shared<const Chain>(_chain))
+    {
+    }
+
+    ChainJntToInverseMassSolver::ChainJntToInverseMassSolver(const ChainConstPtr& _chain):
+        chain_ptr(_chain), chain(*chain_ptr), nj(chain.getNrOfJoints()), ns(chain.getNrOfSegments()),
+        X(ns), T(ns), S(ns), IA(ns), U(ns), D(ns), joint_segment(nj),
+        F(6,nj), P(6,nj), tmp(6,nj), jac(6,nj), jac_H_inv(6,nj)
+    {
+    }
+
+    ChainJntToInverseMassSolver::~ChainJntToInverseMassSolver()
+    {
+    }
+
+    void ChainJntToInverseMassSolver::updateInternalDataStructures()
+    {
+        nj = chain.getNrOfJoints();
+        ns = chain.getNrOfSegments();
+        X.resize(ns);
+        T.resize(ns);
+        S.resize(ns);
+        IA.resize(ns);
+        U.resize(ns);
+        D.resize(ns);
+        joint_segment.resize(nj);
+        F.resize(6,nj);
+        P.resize(6,nj);
+        tmp.resize(6,nj);
+        jac.resize(6,nj);
+        jac_H_inv.resize(6,nj);
+    }
+
+    int ChainJntToInverseMassSolver::JntToInverseMass(const JntArray& q, JntSpaceInertiaMatrix& H_inv)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        return (error = inverseMass(q, H_inv));
+    }
+
+    int ChainJntToInverseMassSolver::JntToInverseMass(const JntArray& q, JntSpaceInertiaMatrix& H_inv,
+                                                      Eigen::Matrix<double,6,6>& JHinvJt, int seg_nr)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        std::size_t segmentNr;
+        if(seg_nr<0)
+            segmentNr=ns;
+        else
+            segmentNr=seg_nr;
+        if(segmentNr>ns)
+            return (error = E_OUT_OF_RANGE);
+
+        error = inverseMass(q, H_inv);
+        if(error != E_NOERROR)
+            return error;
+
+        //Jacobian with reference point at the tip, from the poses of the first sweep
+        const Vector p_tip = segmentNr>0 ? T[segmentNr-1].p : Vector::Zero();
+        jac.setZero();
+        for(std::size_t k=0;k<nj;k++){
+            const std::size_t i=joint_segment[k];
+            if(i>=segmentNr)
+                break;
+            Twist t=(T[i].M*S[i]).RefPoint(p_tip-T[i].p);
+            jac.col(k) << t.vel.x(), t.vel.y(), t.vel.z(), t.rot.x(), t.rot.y(), t.rot.z();
+        }
+        jac_H_inv.noalias()=jac*H_inv.data;
+        JHinvJt.noalias()=jac_H_inv*jac.transpose();
+        return (error = E_NOERROR);
+    }
+
+    int ChainJntToInverseMassSolver::inverseMass(const JntArray& q, JntSpaceInertiaMatrix& H_inv)
+    {
+        if(nj != chain.getNrOfJoints() || ns != chain.getNrOfSegments())
+            return E_NOT_UP_TO_DATE;
+        if(q.rows()!=nj || H_inv.rows()!=nj || H_inv.columns()!=nj)
+            return E_SIZE_MISMATCH;
+
+        //Sweep from root to leaf: poses and rigid body inertias
+        std::size_t j=0;
+        F.setZero();
+        for(std::size_t i=0;i<ns;i++){
+            const Segment& segment=chain.getSegment(i);
+            double q_=0.0;
+            if(segment.getJoint().getType()!=Joint::Fixed){
+                q_=q(j);
+                joint_segment[j]=i;
+                j++;
+            }
+            X[i]=segment.pose(q_);
+            T[i]= i==0 ? X[i] : T[i-1]*X[i];
+            S[i]=X[i].M.Inverse(segment.twist(q_,1.0));
+            IA[i]=segment.getInertia();
+        }
+
+        //Sweep from leaf to root: articulated body inertias, see ChainFdSolver_ABA
+        for(int i=ns-1;i>=0;i--){
+            const Joint& joint=chain.getSegment(i).getJoint();
+            const bool moving=joint.getType()!=Joint::Fixed;
+            if(moving){
+                U[i]=IA[i]*S[i];
+                D[i]=dot(S[i],U[i])+joint.getInertia();
+                if(!(D[i]>0))
+                    return E_UNDEFINED;
+            }
+            if(i!=0){
+                ArticulatedBodyInertia Ia=IA[i];
+                if(moving){
+                    Eigen::Map<const Eigen::Vector3d> Uf(U[i].force.data);
+                    Eigen::Map<const Eigen::Vector3d> Ut(U[i].torque.data);
+                    const double Dinv=1.0/D[i];
+                    Ia.M.noalias()-=Dinv*Uf*Uf.transpose();
+                    Ia.H.noalias()-=Dinv*Ut*Uf.transpose();
+                    Ia.I.noalias()-=Dinv*Ut*Ut.transpose();
+                }
+                IA[i-1]=IA[i-1]+X[i]*Ia;
+            }
+        }
+
+        //Column k of H_inv is the response to a unit torque at joint k.  The
+        //sweeps of all the columns are done at once: column k of F is the bias
+        //force of the current segment due to that torque, column k of P its
+        //acceleration.  Only the upper triangle is computed.
+        typedef Eigen::Map<const Eigen::Matrix<double,3,3,Eigen::RowMajor> > RotationMap;
+        Eigen::Matrix3d p_cross;
+
+        //Sweep from leaf to root: bias forces of the joints after the segment
+        j=nj;
+        for(int i=ns-1;i>=0;i--){
+            if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed){
+                --j;
+                const std::size_t m=nj-j;
+                Eigen::Map<const Eigen::Vector3d> Sv(S[i].vel.data), Sw(S[i].rot.data);
+                Eigen::Map<const Eigen::Vector3d> Uf(U[i].force.data), Ut(U[i].torque.data);
+                const double Dinv=1.0/D[i];
+                //u/D, with u the unit torque minus the bias force along the joint
+                H_inv.data(j,j)=Dinv;
+                H_inv.data.row(j).tail(m-1).noalias()=-Dinv*(Sv.transpose()*F.topRightCorner(3,m-1));
+                H_inv.data.row(j).tail(m-1).noalias()-=Dinv*(Sw.transpose()*F.bottomRightCorner(3,m-1));
+                F.topRightCorner(3,m).noalias()+=Uf*H_inv.data.row(j).tail(m);
+                F.bottomRightCorner(3,m).noalias()+=Ut*H_inv.data.row(j).tail(m);
+            }
+            if(i!=0 && j<nj){
+                //transform to the parent, as Frame*Wrench
+                const std::size_t m=nj-j;
+                RotationMap R(X[i].M.data);
+                p_cross << 0,-X[i].p(2),X[i].p(1), X[i].p(2),0,-X[i].p(0), -X[i].p(1),X[i].p(0),0;
+                tmp.topRightCorner(3,m).noalias()=R*F.topRightCorner(3,m);
+                tmp.bottomRightCorner(3,m).noalias()=R*F.bottomRightCorner(3,m);
+                F.bottomRightCorner(3,m)=tmp.bottomRightCorner(3,m);
+                F.bottomRightCorner(3,m).noalias()+=p_cross*tmp.topRightCorner(3,m);
+                F.topRightCorner(3,m)=tmp.topRightCorner(3,m);
+            }
+        }
+
+        //Sweep from root to leaf: accelerations, without velocity and gravity
+        j=0;
+        for(std::size_t i=0;i<ns && j<nj;i++){
+            const std::size_t m=nj-j;
+            if(i!=0 && j>0){
+                //transform to the segment, as Frame::Inverse(Twist)
+                RotationMap R(X[i].M.data);
+                p_cross << 0,-X[i].p(2),X[i].p(1), X[i].p(2),0,-X[i].p(0), -X[i].p(1),X[i].p(0),0;
+                tmp.topRightCorner(3,m)=P.topRightCorner(3,m);
+                tmp.topRightCorner(3,m).noalias()-=p_cross*P.bottomRightCorner(3,m);
+                P.topRightCorner(3,m).noalias()=R.transpose()*tmp.topRightCorner(3,m);
+                tmp.bottomRightCorner(3,m)=P.bottomRightCorner(3,m);
+                P.bottomRightCorner(3,m).noalias()=R.transpose()*tmp.bottomRightCorner(3,m);
+            }
+            if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed){
+                Eigen::Map<const Eigen::Vector3d> Sv(S[i].vel.data), Sw(S[i].rot.data);
+                Eigen::Map<const Eigen::Vector3d> Uf(U[i].force.data), Ut(U[i].torque.data);
+                if(j>0){
+                    H_inv.data.row(j).tail(m).noalias()-=(1.0/D[i])*(Uf.transpose()*P.topRightCorner(3,m));
+                    H_inv.data.row(j).tail(m).noalias()-=(1.0/D[i])*(Ut.transpose()*P.bottomRightCorner(3,m));
+                }
+                if(j==0){
+                    P.topRightCorner(3,m).noalias()=Sv*H_inv.data.row(j).tail(m);
+                    P.bottomRightCorner(3,m).noalias()=Sw*H_inv.data.row(j).tail(m);
+                }else{
+                    P.topRightCorner(3,m).noalias()+=Sv*H_inv.data.row(j).tail(m);
+                    P.bottomRightCorner(3,m).noalias()+=Sw*H_inv.data.row(j).tail(m);
+                }
+                j++;
+            }
+        }
+
+        H_inv.data.triangularView<Eigen::StrictlyLower>()=H_inv.data.transpose();
+        return E_NOERROR;
+    }
+}
@@ -0,0 +1,102 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_CHAINJNTTOINVERSEMASSSOLVER_HPP
+#define KDL_CHAINJNTTOINVERSEMASSSOLVER_HPP
+
+#include "chain.hpp"
+#include "jntarray.hpp"
+#include "jntspaceinertiamatrix.hpp"
+#include "articulatedbodyinertia.hpp"
+#include "solveri.hpp"
+
+#include <Eigen/Core>
+
+namespace KDL
+{
+    /**
+     * \brief Computes the inverse of the joint space inertia matrix of a
+     * chain without forming and factoring the matrix.
+     *
+     * The articulated-body inertias of the segments depend on q only, so
+     * they are computed once (as in ChainFdSolver_ABA).  Column k of
+     * \f$ H^{-1} \f$ is then the acceleration caused by a unit torque at
+     * joint k without velocity and gravity.  The columns are swept together,
+     * one sweep from the leaf to the root and one back, in O(n^2) instead
+     * of the O(n^3) factorization.
+     *
+     * The joint rotor inertias are included, as in ChainDynParam::JntToMass.
+     *
+     * @ingroup KinematicFamily
+     */
+    class ChainJntToInverseMassSolver : public SolverI
+    {
+    public:
+        explicit ChainJntToInverseMassSolver(const Chain& chain);
+        /// Shares the immutable \a chain with other solvers instead of copying it.
+        explicit ChainJntToInverseMassSolver(const ChainConstPtr& chain);
+        virtual ~ChainJntToInverseMassSolver();
+
+        /**
+         * Calculates the inverse of the joint space inertia matrix.
+         *
+         * @param q joint positions
+         * @param H_inv output inverse joint space inertia matrix
+         * @return E_UNDEFINED if a joint moves no mass (the matrix is singular)
+         */
+        int JntToInverseMass(const JntArray& q, JntSpaceInertiaMatrix& H_inv);
+
+        /**
+         * Same as above, and also calculates \f$ J H^{-1} J^T \f$, the
+         * inverse of the operational space inertia at a tip, with J the
+         * Jacobian of ChainJntToJacSolver: expressed in the base frame of
+         * the chain, with reference point at the tip.
+         *
+         * @param q joint positions
+         * @param H_inv output inverse joint space inertia matrix
+         * @param JHinvJt output 6x6 matrix, rows and columns ordered as the Jacobian
+         * @param seg_nr the tip is the end of this many segments, -1 for the whole chain
+         * @return E_OUT_OF_RANGE if \a seg_nr is larger than the number of segments
+         */
+        int JntToInverseMass(const JntArray& q, JntSpaceInertiaMatrix& H_inv,
+                             Eigen::Matrix<double,6,6>& JHinvJt, int seg_nr=-1);
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+    private:
+        int inverseMass(const JntArray& q, JntSpaceInertiaMatrix& H_inv);
+
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
+        std::size_t nj;
+        std::size_t ns;
+        std::vector<Frame> X;
+        std::vector<Frame> T;   // pose of the segments with respect to the base
+        std::vector<Twist> S;
+        std::vector<ArticulatedBodyInertia> IA;
+        std::vector<Wrench> U;
+        std::vector<double> D;
+        std::vector<std::size_t> joint_segment;
+        Eigen::Matrix<double,6,Eigen::Dynamic> F;     // bias forces (force; torque) per unit torque
+        Eigen::Matrix<double,6,Eigen::Dynamic> P;     // accelerations (vel; rot) per unit torque
+        Eigen::Matrix<double,6,Eigen::Dynamic> tmp;
+        Eigen::Matrix<double,6,Eigen::Dynamic> jac;
+        Eigen::Matrix<double,6,Eigen::Dynamic> jac_H_inv;
+    };
+}
+
+#endif
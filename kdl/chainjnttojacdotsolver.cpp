@@ -32,14 +32,20 @@ const int ChainJntToJacDotSolver::BODYFIXED;
 const int ChainJntToJacDotSolver::INERTIAL;
 
 ChainJntToJacDotSolver::ChainJntToJacDotSolver(const Chain& _chain):
-    chain(_chain),
+    ChainJntToJacDotSolver(std::make_shared<const Chain>(_chain))
+{
+}
+
+ChainJntToJacDotSolver::ChainJntToJacDotSolver(const ChainConstPtr& _chain):
+    chain_ptr(_chain),
+    chain(*chain_ptr),
     locked_joints_(chain.getNrOfJoints(),false),
     nr_of_unlocked_joints_(chain.getNrOfJoints()),
-    jac_solver_(chain),
+    jac_solver_(chain_ptr),
     jac_(chain.getNrOfJoints()),
     jac_dot_(chain.getNrOfJoints()),
     representation_(HYBRID),
-    fk_solver_(chain)
+    fk_solver_(chain_ptr)
 {
 }
 
@@ -64,6 +70,7 @@ int ChainJntToJacDotSolver::JntToJacDot(const JntArrayVel& q_in, Twist& jac_dot_
 
 int ChainJntToJacDotSolver::JntToJacDot(const JntArrayVel& q_in, Jacobian& jdot, int seg_nr)
 {
+    KDL_SOLVER_TELEMETRY_SCOPE();
     if(locked_joints_.size() != chain.getNrOfJoints())
         return (error = E_NOT_UP_TO_DATE);
 
@@ -60,6 +60,8 @@ public:
     static const int INERTIAL = 2;
 
     explicit ChainJntToJacDotSolver(const Chain& chain);
+    /// Shares the immutable \a chain with other solvers instead of copying it.
+    explicit ChainJntToJacDotSolver(const ChainConstPtr& chain);
     virtual ~ChainJntToJacDotSolver();
     /**
      * @brief Computes \f$ {}_{bs}\dot{J}^{ee}.\dot{q} \f$
@@ -165,7 +167,8 @@ protected:
                                const int& representation);
 private:
 
-    const Chain chain;
+    const ChainConstPtr chain_ptr;
+    const Chain& chain;
     std::vector<bool> locked_joints_;
     std::size_t nr_of_unlocked_joints_;
     ChainJntToJacSolver jac_solver_;
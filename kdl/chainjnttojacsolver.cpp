@@ -20,11 +20,18 @@
 // Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include "chainjnttojacsolver.hpp"
+#include <utility>
 
 namespace KDL
 {
     ChainJntToJacSolver::ChainJntToJacSolver(const Chain& _chain):
-        chain(_chain),locked_joints_(chain.getNrOfJoints(),false)
+        ChainJntToJacSolver(std::make_shared<const Chain>(_chain))
+    {
+    }
+
+    ChainJntToJacSolver::ChainJntToJacSolver(const ChainConstPtr& _chain):
+        chain_ptr(_chain),
+        chain(*chain_ptr),locked_joints_(chain.getNrOfJoints(),false)
     {
     }
 
@@ -46,9 +53,15 @@ namespace KDL
     }
 
     int ChainJntToJacSolver::JntToJac(const JntArray& q_in, Jacobian& jac, int seg_nr)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        return (error = std::as_const(*this).JntToJac(q_in, jac, seg_nr));
+    }
+
+    int ChainJntToJacSolver::JntToJac(const JntArray& q_in, Jacobian& jac, int seg_nr) const
     {
         if(locked_joints_.size() != chain.getNrOfJoints())
-            return (error = E_NOT_UP_TO_DATE);
+            return E_NOT_UP_TO_DATE;
         std::size_t segmentNr;
         if(seg_nr<0)
             segmentNr=chain.getNrOfSegments();
@@ -59,12 +72,12 @@ namespace KDL
         SetToZero(jac) ;
 
         if( q_in.rows()!=chain.getNrOfJoints() || jac.columns() != chain.getNrOfJoints())
-            return (error = E_SIZE_MISMATCH);
+            return E_SIZE_MISMATCH;
         else if(segmentNr>chain.getNrOfSegments())
-            return (error = E_OUT_OF_RANGE);
+            return E_OUT_OF_RANGE;
 
-        T_tmp = Frame::Identity();
-        SetToZero(t_tmp);
+        Frame T_tmp = Frame::Identity();
+        Twist t_tmp = Twist::Zero();
         int j=0;
         int k=0;
         Frame total;
@@ -95,7 +108,7 @@ namespace KDL
 
             T_tmp = total;
         }
-        return (error = E_NOERROR);
+        return E_NOERROR;
     }
 }
 
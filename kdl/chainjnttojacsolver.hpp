@@ -43,6 +43,8 @@ namespace KDL
     public:
 
         explicit ChainJntToJacSolver(const Chain& chain);
+        /// Shares the immutable \a chain with other solvers instead of copying it.
+        explicit ChainJntToJacSolver(const ChainConstPtr& chain);
         virtual ~ChainJntToJacSolver();
         /**
          * Calculate the jacobian expressed in the base frame of the
@@ -57,6 +59,17 @@ namespace KDL
          */
         virtual int JntToJac(const JntArray& q_in, Jacobian& jac, int seg_nr=-1);
 
+        /**
+         * Thread-safe variant of JntToJac(): it only reads the chain and
+         * the locked joints and does not store the latest error, so a
+         * single solver can be shared by several threads. All
+         * intermediate values live on the stack, hence no workspace has
+         * to be passed in.
+         *
+         * @return the same error codes as the non-const variant
+         */
+        int JntToJac(const JntArray& q_in, Jacobian& jac, int seg_nr=-1) const;
+
         /**
          *
          * @param locked_joints new values for locked joints
@@ -68,9 +81,8 @@ namespace KDL
         virtual void updateInternalDataStructures();
 
     private:
-        const Chain chain;
-        Twist t_tmp;
-        Frame T_tmp;
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
         std::vector<bool> locked_joints_;
     };
 }
@@ -0,0 +1,190 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainjnttoregressorsolver.hpp"
+
+namespace KDL
+{
+    const unsigned int ChainJntToRegressorSolver::SEGMENT_PARAMETERS;
+
+    namespace
+    {
+        //Momentum I*t of the inertia with only parameter c equal to one,
+        //see operator*(const RigidBodyInertia&, const Twist&)
+        Wrench unitMomentum(unsigned int c, const Twist& t)
+        {
+            const Vector& w=t.rot;
+            switch(c){
+            case 0:
+                return Wrench(t.vel,Vector::Zero());
+            case 1:
+            case 2:
+            case 3:{
+                Vector e=Vector::Zero();
+                e(c-1)=1.0;
+                return Wrench(-(e*w),e*t.vel);
+            }
+            case 4:
+                return Wrench(Vector::Zero(),Vector(w.x(),0,0));
+            case 5:
+                return Wrench(Vector::Zero(),Vector(0,w.y(),0));
+            case 6:
+                return Wrench(Vector::Zero(),Vector(0,0,w.z()));
+            case 7:
+                return Wrench(Vector::Zero(),Vector(w.y(),w.x(),0));
+            case 8:
+                return Wrench(Vector::Zero(),Vector(w.z(),0,w.x()));
+            default:
+                return Wrench(Vector::Zero(),Vector(0,w.z(),w.y()));
+            }
+        }
+    }
+
+    ChainJntToRegressorSolver::ChainJntToRegressorSolver(const Chain& _chain, Vector grav):
+        ChainJntToRegressorSolver(std::make_shared<const Chain>(_chain), grav)
+    {
+    }
+
+    ChainJntToRegressorSolver::ChainJntToRegressorSolver(const ChainConstPtr& _chain, Vector grav):
+        chain_ptr(_chain), chain(*chain_ptr), nj(chain.getNrOfJoints()), ns(chain.getNrOfSegments()),
+        ag(-Twist(grav,Vector::Zero())),
+        X(ns), S(ns), v(ns), a(ns), joint_nr(ns),
+        Y_sample(nj,SEGMENT_PARAMETERS*ns),
+        YtY(SEGMENT_PARAMETERS*ns,SEGMENT_PARAMETERS*ns),
+        YtTau(SEGMENT_PARAMETERS*ns)
+    {
+        resetAccumulation();
+    }
+
+    ChainJntToRegressorSolver::~ChainJntToRegressorSolver()
+    {
+    }
+
+    void ChainJntToRegressorSolver::updateInternalDataStructures()
+    {
+        nj = chain.getNrOfJoints();
+        ns = chain.getNrOfSegments();
+        X.resize(ns);
+        S.resize(ns);
+        v.resize(ns);
+        a.resize(ns);
+        joint_nr.resize(ns);
+        Y_sample.resize(nj,SEGMENT_PARAMETERS*ns);
+        YtY.resize(SEGMENT_PARAMETERS*ns,SEGMENT_PARAMETERS*ns);
+        YtTau.resize(SEGMENT_PARAMETERS*ns);
+        resetAccumulation();
+    }
+
+    void ChainJntToRegressorSolver::resetAccumulation()
+    {
+        YtY.setZero();
+        YtTau.setZero();
+        nr_of_samples=0;
+    }
+
+    int ChainJntToRegressorSolver::JntToRegressor(const JntArray& q, const JntArray& q_dot, const JntArray& q_dotdot, Eigen::MatrixXd& Y)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        if((std::size_t)Y.rows()!=nj || (std::size_t)Y.cols()!=SEGMENT_PARAMETERS*ns)
+            return (error = E_SIZE_MISMATCH);
+        return (error = regressor(q, q_dot, q_dotdot, Y));
+    }
+
+    int ChainJntToRegressorSolver::accumulate(const JntArray& q, const JntArray& q_dot, const JntArray& q_dotdot, const JntArray& torques)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        if(torques.rows()!=nj)
+            return (error = E_SIZE_MISMATCH);
+        error = regressor(q, q_dot, q_dotdot, Y_sample);
+        if(error != E_NOERROR)
+            return error;
+
+        YtY.noalias()+=Y_sample.transpose()*Y_sample;
+        YtTau.noalias()+=Y_sample.transpose()*torques.data;
+        nr_of_samples++;
+        return (error = E_NOERROR);
+    }
+
+    int ChainJntToRegressorSolver::getParameters(Eigen::VectorXd& pi) const
+    {
+        if((std::size_t)pi.rows()!=SEGMENT_PARAMETERS*ns)
+            return E_SIZE_MISMATCH;
+        for(std::size_t i=0;i<ns;i++){
+            const RigidBodyInertia& I=chain.getSegment(i).getInertia();
+            const double m=I.getMass();
+            const Vector h=m*I.getCOG();
+            const RotationalInertia Ir=I.getRotationalInertia();
+            pi.segment<SEGMENT_PARAMETERS>(SEGMENT_PARAMETERS*i) <<
+                m, h.x(), h.y(), h.z(), Ir.data[0], Ir.data[4], Ir.data[8], Ir.data[1], Ir.data[2], Ir.data[5];
+        }
+        return E_NOERROR;
+    }
+
+    int ChainJntToRegressorSolver::regressor(const JntArray& q, const JntArray& q_dot, const JntArray& q_dotdot, Eigen::MatrixXd& Y)
+    {
+        if(nj != chain.getNrOfJoints() || ns != chain.getNrOfSegments())
+            return E_NOT_UP_TO_DATE;
+        if(q.rows()!=nj || q_dot.rows()!=nj || q_dotdot.rows()!=nj)
+            return E_SIZE_MISMATCH;
+
+        //Sweep from root to leaf: velocities and accelerations, as ChainIdSolver_RNE
+        std::size_t j=0;
+        for(std::size_t i=0;i<ns;i++){
+            const Segment& segment=chain.getSegment(i);
+            double q_,qdot_,qdotdot_;
+            if(segment.getJoint().getType()!=Joint::Fixed){
+                q_=q(j);
+                qdot_=q_dot(j);
+                qdotdot_=q_dotdot(j);
+                joint_nr[i]=j;
+                j++;
+            }else{
+                q_=qdot_=qdotdot_=0.0;
+                joint_nr[i]=-1;
+            }
+            X[i]=segment.pose(q_);
+            S[i]=X[i].M.Inverse(segment.twist(q_,1.0));
+            const Twist vj=S[i]*qdot_;
+            if(i==0){
+                v[i]=vj;
+                a[i]=X[i].Inverse(ag)+S[i]*qdotdot_+v[i]*vj;
+            }else{
+                v[i]=X[i].Inverse(v[i-1])+vj;
+                a[i]=X[i].Inverse(a[i-1])+S[i]*qdotdot_+v[i]*vj;
+            }
+        }
+
+        //The force of segment i, I a + v x* (I v), is linear in its
+        //parameters.  Column c of its block of Y is the torque of the joints
+        //from segment i down to the root due to the force with only
+        //parameter c equal to one.
+        Y.setZero();
+        Wrench F[SEGMENT_PARAMETERS];
+        for(std::size_t i=0;i<ns;i++){
+            for(unsigned int c=0;c<SEGMENT_PARAMETERS;c++)
+                F[c]=unitMomentum(c,a[i])+v[i]*unitMomentum(c,v[i]);
+            for(int k=i;k>=0;k--){
+                if(joint_nr[k]>=0)
+                    for(unsigned int c=0;c<SEGMENT_PARAMETERS;c++)
+                        Y(joint_nr[k],SEGMENT_PARAMETERS*i+c)=dot(S[k],F[c]);
+                if(k!=0)
+                    for(unsigned int c=0;c<SEGMENT_PARAMETERS;c++)
+                        F[c]=X[k]*F[c];
+            }
+        }
+        return E_NOERROR;
+    }
+}
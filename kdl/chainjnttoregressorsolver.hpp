@@ -0,0 +1,124 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_CHAINJNTTOREGRESSORSOLVER_HPP
+#define KDL_CHAINJNTTOREGRESSORSOLVER_HPP
+
+#include "chain.hpp"
+#include "jntarray.hpp"
+#include "solveri.hpp"
+
+#include <Eigen/Core>
+
+namespace KDL
+{
+    /**
+     * \brief Computes the dynamic parameter regressor of a chain, for the
+     * identification of the inertial parameters.
+     *
+     * The joint torques of ChainIdSolver_RNE, without external forces and
+     * joint rotor inertias, are linear in the inertial parameters of the
+     * segments: \f$ \tau = Y(q, \dot q, \ddot q) \pi \f$.  Every segment has
+     * ten parameters, in the order
+     * (m, h_x, h_y, h_z, I_xx, I_yy, I_zz, I_xy, I_xz, I_yz), with
+     * h = m c the first moment of mass and I the rotational inertia, both
+     * with respect to the segment frame as returned by RigidBodyInertia.
+     * The parameters of segment i are columns 10 i to 10 i + 9 of Y.
+     *
+     * For long logs the samples can be accumulated into
+     * \f$ Y^T Y \f$ and \f$ Y^T \tau \f$ instead of stacking Y, so that the
+     * memory does not grow with the number of samples; the least squares
+     * estimate then solves \f$ Y^T Y \pi = Y^T \tau \f$.
+     *
+     * @ingroup KinematicFamily
+     */
+    class ChainJntToRegressorSolver : public SolverI
+    {
+    public:
+        /// Number of inertial parameters of a segment.
+        static const unsigned int SEGMENT_PARAMETERS = 10;
+
+        /**
+         * @param chain the chain to calculate the regressor for, an internal copy will be made
+         * @param grav the gravity vector
+         */
+        ChainJntToRegressorSolver(const Chain& chain, Vector grav);
+        /// Shares the immutable \a chain with other solvers instead of copying it.
+        ChainJntToRegressorSolver(const ChainConstPtr& chain, Vector grav);
+        virtual ~ChainJntToRegressorSolver();
+
+        /**
+         * Calculates the regressor.
+         *
+         * @param q joint positions
+         * @param q_dot joint velocities
+         * @param q_dotdot joint accelerations
+         * @param Y output nj x 10 ns regressor
+         */
+        int JntToRegressor(const JntArray& q, const JntArray& q_dot, const JntArray& q_dotdot, Eigen::MatrixXd& Y);
+
+        /**
+         * Adds one sample to \f$ Y^T Y \f$ and \f$ Y^T \tau \f$.
+         *
+         * @param torques the measured joint torques, without the torques
+         * of the rotor inertias and friction
+         */
+        int accumulate(const JntArray& q, const JntArray& q_dot, const JntArray& q_dotdot, const JntArray& torques);
+
+        /// Clears the accumulated samples.
+        void resetAccumulation();
+
+        /// The accumulated \f$ Y^T Y \f$, 10 ns x 10 ns.
+        const Eigen::MatrixXd& getYtY() const { return YtY; }
+
+        /// The accumulated \f$ Y^T \tau \f$, 10 ns.
+        const Eigen::VectorXd& getYtTau() const { return YtTau; }
+
+        /// Number of accumulated samples.
+        std::size_t getNrOfSamples() const { return nr_of_samples; }
+
+        /**
+         * Gets the inertial parameters of the segments of the chain, in the
+         * order of the columns of the regressor.
+         *
+         * @param pi output vector of size 10 ns
+         */
+        int getParameters(Eigen::VectorXd& pi) const;
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+    private:
+        int regressor(const JntArray& q, const JntArray& q_dot, const JntArray& q_dotdot, Eigen::MatrixXd& Y);
+
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
+        std::size_t nj;
+        std::size_t ns;
+        Twist ag;
+        std::vector<Frame> X;
+        std::vector<Twist> S;
+        std::vector<Twist> v;
+        std::vector<Twist> a;
+        std::vector<int> joint_nr;
+        Eigen::MatrixXd Y_sample;
+        Eigen::MatrixXd YtY;
+        Eigen::VectorXd YtTau;
+        std::size_t nr_of_samples;
+    };
+}
+
+#endif
@@ -0,0 +1,301 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainsimulator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace KDL
+{
+    namespace
+    {
+        //Butcher tableaus, a[s][j] is the weight of stage j in the state of stage s
+        const double rk4_a[4][7] = {
+            {0.0},
+            {0.5},
+            {0.0, 0.5},
+            {0.0, 0.0, 1.0}
+        };
+        const double rk4_b[4] = {1.0/6.0, 1.0/3.0, 1.0/3.0, 1.0/6.0};
+
+        //Dormand-Prince 5(4).  The last stage is evaluated at the new state, so
+        //it is the first stage of the next substep.
+        const double dopri_a[7][7] = {
+            {0.0},
+            {1.0/5.0},
+            {3.0/40.0, 9.0/40.0},
+            {44.0/45.0, -56.0/15.0, 32.0/9.0},
+            {19372.0/6561.0, -25360.0/2187.0, 64448.0/6561.0, -212.0/729.0},
+            {9017.0/3168.0, -355.0/33.0, 46732.0/5247.0, 49.0/176.0, -5103.0/18656.0},
+            {35.0/384.0, 0.0, 500.0/1113.0, 125.0/192.0, -2187.0/6784.0, 11.0/84.0}
+        };
+        //difference of the fifth and fourth order solutions
+        const double dopri_e[7] = {71.0/57600.0, 0.0, -71.0/16695.0, 71.0/1920.0, -17253.0/339200.0, 22.0/525.0, -1.0/40.0};
+    }
+
+    ChainSimulator::Workspace::Workspace(const ChainConstPtr& chain, const Vector& grav) :
+        fdsolver(chain, grav)
+    {
+        resize(chain->getNrOfJoints());
+    }
+
+    void ChainSimulator::Workspace::resize(std::size_t nj)
+    {
+        fdsolver.updateInternalDataStructures();
+        q.resize(nj);
+        q_dot.resize(nj);
+        torques.resize(nj);
+        q_stage.resize(nj);
+        q_dot_stage.resize(nj);
+        q_dotdot.resize(nj);
+        k_q.resize(nj,7);
+        k_q_dot.resize(nj,7);
+    }
+
+    ChainSimulator::ChainSimulator(const Chain& _chain, Vector grav, Method _method, std::size_t nr_of_threads) :
+        ChainSimulator(std::make_shared<const Chain>(_chain), grav, _method, nr_of_threads)
+    {
+    }
+
+    ChainSimulator::ChainSimulator(const ChainConstPtr& _chain, Vector grav, Method _method, std::size_t nr_of_threads) :
+        chain_ptr(_chain), chain(*chain_ptr), nj(0), method(_method),
+        abs_tol(1e-6), rel_tol(1e-6), max_nr_of_substeps(1000),
+        default_torque_model(true),
+        pool(nr_of_threads),
+        workspaces(pool.size(), Workspace(chain_ptr, grav)),
+        substep(0.0), last_nr_of_substeps(0)
+    {
+        updateInternalDataStructures();
+    }
+
+    ChainSimulator::~ChainSimulator()
+    {
+    }
+
+    void ChainSimulator::updateInternalDataStructures()
+    {
+        nj = chain.getNrOfJoints();
+        if(default_torque_model)
+            torque_model = std::make_shared<const JointFrictionModel>(chain);
+        for(std::size_t t=0;t<workspaces.size();t++){
+            workspaces[t].resize(nj);
+            workspaces[t].fdsolver.setJointTorqueModel(torque_model);
+        }
+        substep=0.0;
+        substeps.clear();
+    }
+
+    void ChainSimulator::setTolerances(double _abs_tol, double _rel_tol)
+    {
+        abs_tol=_abs_tol;
+        rel_tol=_rel_tol;
+    }
+
+    void ChainSimulator::setMaxNrOfSubsteps(unsigned int _max_nr_of_substeps)
+    {
+        max_nr_of_substeps=_max_nr_of_substeps;
+    }
+
+    void ChainSimulator::setNrOfInstances(std::size_t nr_of_instances)
+    {
+        substeps.assign(nr_of_instances, 0.0);
+        codes.resize(nr_of_instances);
+    }
+
+    void ChainSimulator::setJointTorqueModel(const JointTorqueModelConstPtr& model)
+    {
+        default_torque_model = !model;
+        if(model)
+            torque_model = model;
+        else
+            torque_model = std::make_shared<const JointFrictionModel>(chain);
+        for(std::size_t t=0;t<workspaces.size();t++)
+            workspaces[t].fdsolver.setJointTorqueModel(torque_model);
+    }
+
+    int ChainSimulator::step(JntArray& q, JntArray& q_dot, const JntArray& torques, const Wrenches& f_ext, double dt)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE_ITER(last_nr_of_substeps);
+        if(nj != chain.getNrOfJoints())
+            return (error = E_NOT_UP_TO_DATE);
+        if(q.rows()!=nj || q_dot.rows()!=nj || torques.rows()!=nj || f_ext.size()!=chain.getNrOfSegments())
+            return (error = E_SIZE_MISMATCH);
+
+        Workspace& ws=workspaces[0];
+        ws.q.data=q.data;
+        ws.q_dot.data=q_dot.data;
+        ws.torques.data=torques.data;
+        error = integrate(ws, &f_ext, dt, substep, last_nr_of_substeps);
+        q.data=ws.q.data;
+        q_dot.data=ws.q_dot.data;
+        return error;
+    }
+
+    int ChainSimulator::step(JntArray& q, JntArray& q_dot, const JntArray& torques, double dt)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE_ITER(last_nr_of_substeps);
+        if(nj != chain.getNrOfJoints())
+            return (error = E_NOT_UP_TO_DATE);
+        if(q.rows()!=nj || q_dot.rows()!=nj || torques.rows()!=nj)
+            return (error = E_SIZE_MISMATCH);
+
+        Workspace& ws=workspaces[0];
+        ws.q.data=q.data;
+        ws.q_dot.data=q_dot.data;
+        ws.torques.data=torques.data;
+        error = integrate(ws, NULL, dt, substep, last_nr_of_substeps);
+        q.data=ws.q.data;
+        q_dot.data=ws.q_dot.data;
+        return error;
+    }
+
+    int ChainSimulator::step(Eigen::MatrixXd& q, Eigen::MatrixXd& q_dot, const Eigen::MatrixXd& torques, double dt)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        if(nj != chain.getNrOfJoints())
+            return (error = E_NOT_UP_TO_DATE);
+        if((std::size_t)q.rows()!=nj || q_dot.rows()!=q.rows() || q_dot.cols()!=q.cols() ||
+           torques.rows()!=q.rows() || torques.cols()!=q.cols())
+            return (error = E_SIZE_MISMATCH);
+
+        const std::size_t n=q.cols();
+        if(substeps.size()!=n)
+            setNrOfInstances(n);
+        pool.parallel_for(n, [&](std::size_t k, std::size_t t) {
+            Workspace& ws=workspaces[t];
+            ws.q.data=q.col(k);
+            ws.q_dot.data=q_dot.col(k);
+            ws.torques.data=torques.col(k);
+            unsigned int nr_of_substeps;
+            codes[k]=integrate(ws, NULL, dt, substeps[k], nr_of_substeps);
+            q.col(k)=ws.q.data;
+            q_dot.col(k)=ws.q_dot.data;
+        });
+
+        for(std::size_t k=0;k<n;k++)
+            if(codes[k]!=E_NOERROR)
+                return (error = codes[k]);
+        return (error = E_NOERROR);
+    }
+
+    int ChainSimulator::integrate(Workspace& ws, const Wrenches* f_ext, double dt, double& h_next, unsigned int& nr_of_substeps) const
+    {
+        int rc;
+        nr_of_substeps=0;
+        switch(method){
+        case SemiImplicitEuler:
+            ws.q_stage.data=ws.q.data;
+            ws.q_dot_stage.data=ws.q_dot.data;
+            rc=derivative(ws, f_ext);
+            if(rc!=E_NOERROR)
+                return rc;
+            ws.q_dot.data+=dt*ws.q_dotdot.data;
+            ws.q.data+=dt*ws.q_dot.data;
+            nr_of_substeps=1;
+            return E_NOERROR;
+
+        case RK4:
+            rc=stages(ws, f_ext, 4, rk4_a, dt, false);
+            if(rc!=E_NOERROR)
+                return rc;
+            for(int j=0;j<4;j++){
+                ws.q.data+=(dt*rk4_b[j])*ws.k_q.col(j);
+                ws.q_dot.data+=(dt*rk4_b[j])*ws.k_q_dot.col(j);
+            }
+            nr_of_substeps=1;
+            return E_NOERROR;
+
+        case RK45:
+            break;
+        }
+
+        double t=0.0;
+        double h=(h_next>0.0 && h_next<dt) ? h_next : dt;
+        bool first_valid=false;
+        for(unsigned int attempt=0;t<dt;attempt++){
+            if(attempt==max_nr_of_substeps)
+                return E_MAX_ITERATIONS_EXCEEDED;
+            const bool last=t+h>=dt;
+            //the substep proposed by the controller, before it is cut to
+            //end at dt
+            const double h_proposed=h;
+            if(last)
+                h=dt-t;
+            rc=stages(ws, f_ext, 7, dopri_a, h, first_valid);
+            if(rc!=E_NOERROR)
+                return rc;
+            first_valid=true;
+
+            //the last stage is at the fifth order solution, the error is
+            //measured against the fourth order one
+            double err=0.0;
+            for(std::size_t i=0;i<nj;i++){
+                double e_q=0.0,e_q_dot=0.0;
+                for(int j=0;j<7;j++){
+                    e_q+=dopri_e[j]*ws.k_q(i,j);
+                    e_q_dot+=dopri_e[j]*ws.k_q_dot(i,j);
+                }
+                err=std::max(err, std::abs(h*e_q)/(abs_tol+rel_tol*std::max(std::abs(ws.q(i)),std::abs(ws.q_stage(i)))));
+                err=std::max(err, std::abs(h*e_q_dot)/(abs_tol+rel_tol*std::max(std::abs(ws.q_dot(i)),std::abs(ws.q_dot_stage(i)))));
+            }
+            if(err<=1.0){
+                ws.q.data=ws.q_stage.data;
+                ws.q_dot.data=ws.q_dot_stage.data;
+                ws.k_q.col(0)=ws.k_q.col(6);
+                ws.k_q_dot.col(0)=ws.k_q_dot.col(6);
+                t= last ? dt : t+h;
+                nr_of_substeps++;
+            }
+            h*= err>0.0 ? std::min(5.0, std::max(0.2, 0.9*std::pow(err,-0.2))) : 5.0;
+            //a short last substep says nothing against the proposed one,
+            //the next step must not start from the remainder
+            if(last && err<=1.0)
+                h=std::max(h,h_proposed);
+        }
+        h_next=h;
+        return E_NOERROR;
+    }
+
+    int ChainSimulator::stages(Workspace& ws, const Wrenches* f_ext, int nr_of_stages, const double (*a)[7], double h, bool first_valid) const
+    {
+        for(int s= first_valid ? 1 : 0;s<nr_of_stages;s++){
+            ws.q_stage.data=ws.q.data;
+            ws.q_dot_stage.data=ws.q_dot.data;
+            for(int j=0;j<s;j++){
+                if(a[s][j]!=0.0){
+                    ws.q_stage.data+=(h*a[s][j])*ws.k_q.col(j);
+                    ws.q_dot_stage.data+=(h*a[s][j])*ws.k_q_dot.col(j);
+                }
+            }
+            const int rc=derivative(ws, f_ext);
+            if(rc!=E_NOERROR)
+                return rc;
+            ws.k_q.col(s)=ws.q_dot_stage.data;
+            ws.k_q_dot.col(s)=ws.q_dotdot.data;
+        }
+        return E_NOERROR;
+    }
+
+    int ChainSimulator::derivative(Workspace& ws, const Wrenches* f_ext) const
+    {
+        //accelerations at q_stage, q_dot_stage, the solver adds the passive
+        //torques of the joints
+        if(f_ext)
+            return ws.fdsolver.CartToJnt(ws.q_stage, ws.q_dot_stage, ws.torques, *f_ext, ws.q_dotdot);
+        return ws.fdsolver.CartToJnt(ws.q_stage, ws.q_dot_stage, ws.torques, ws.q_dotdot);
+    }
+}
@@ -0,0 +1,179 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_CHAINSIMULATOR_HPP
+#define KDL_CHAINSIMULATOR_HPP
+
+#include "chainfdsolver_aba.hpp"
+#include "utilities/thread_pool.hpp"
+
+#include <Eigen/Core>
+#include <vector>
+
+namespace KDL
+{
+    /**
+     * \brief Integrates the motion of a chain under given joint torques.
+     *
+     * The joint accelerations are computed by ChainFdSolver_ABA, with the
+     * passive torques of a JointTorqueModel added to the applied torques.
+     * By default it is a JointFrictionModel of the chain: the damping and
+     * stiffness of the joints give the torques \f$ -d \dot q - k q \f$
+     * (the spring is relaxed at q = 0).  The torques and external forces
+     * are held constant during a step.
+     *
+     * Integration methods:
+     *  - SemiImplicitEuler: one evaluation per step, velocity first, then
+     *    position with the new velocity.
+     *  - RK4: classical fourth order Runge-Kutta, four evaluations per step.
+     *  - RK45: Dormand-Prince 5(4) with error control.  A step is split
+     *    into as many substeps as the tolerances require; the substep size
+     *    is kept between steps.
+     *
+     * All workspaces are owned by the simulator: stepping does not allocate
+     * memory.  The matrix version of step() advances many independent
+     * instances of the chain, distributed over the threads of a ThreadPool.
+     * It allocates the state of the instances when their number changes,
+     * setNrOfInstances() does so in advance.
+     *
+     * @ingroup KinematicFamily
+     */
+    class ChainSimulator : public SolverI
+    {
+    public:
+        enum Method { SemiImplicitEuler, RK4, RK45 };
+
+        /**
+         * @param chain the chain to simulate, an internal copy will be made
+         * @param grav the gravity vector
+         * @param method the integration method
+         * @param nr_of_threads number of threads used by the matrix version
+         *        of step(), including the calling thread.  0 selects the
+         *        number of hardware threads.
+         */
+        ChainSimulator(const Chain& chain, Vector grav, Method method=RK4, std::size_t nr_of_threads=1);
+        /// Shares the immutable \a chain with other solvers instead of copying it.
+        ChainSimulator(const ChainConstPtr& chain, Vector grav, Method method=RK4, std::size_t nr_of_threads=1);
+        ~ChainSimulator();
+
+        void setMethod(Method method) { this->method = method; }
+        Method getMethod() const { return method; }
+
+        /**
+         * Sets the tolerances of RK45.  A substep is accepted if the
+         * estimated error of every joint position and velocity x is below
+         * abs_tol + rel_tol * |x|.
+         */
+        void setTolerances(double abs_tol, double rel_tol);
+
+        /// Sets the maximum number of RK45 substeps in one step, accepted or not.
+        void setMaxNrOfSubsteps(unsigned int max_nr_of_substeps);
+
+        /**
+         * Allocates the state of \a nr_of_instances instances for the
+         * matrix version of step(), which then does not allocate memory
+         * for that number of columns.  The RK45 substep sizes of the
+         * instances are reset.
+         */
+        void setNrOfInstances(std::size_t nr_of_instances);
+
+        /**
+         * Sets the friction, damping and elasticity of the joints, e.g. a
+         * JointFrictionModel with Stribeck friction.  NULL restores the
+         * default model.  \a model is shared by the threads, not copied.
+         */
+        void setJointTorqueModel(const JointTorqueModelConstPtr& model);
+        const JointTorqueModelConstPtr& getJointTorqueModel() const { return torque_model; }
+
+        /**
+         * Advances the joint positions and velocities by \a dt.
+         *
+         * @param q joint positions, updated
+         * @param q_dot joint velocities, updated
+         * @param torques joint torques applied during the step
+         * @param f_ext external forces on the segments during the step
+         * @param dt the time step
+         * @return E_MAX_ITERATIONS_EXCEEDED if RK45 needs more substeps than
+         * allowed, the error of ChainFdSolver_ABA if it fails
+         */
+        int step(JntArray& q, JntArray& q_dot, const JntArray& torques, const Wrenches& f_ext, double dt);
+
+        /**
+         * Same as above, without external forces.
+         */
+        int step(JntArray& q, JntArray& q_dot, const JntArray& torques, double dt);
+
+        /**
+         * Advances N independent instances of the chain by \a dt, without
+         * external forces.  The instances are the columns of the matrices.
+         * With RK45 every instance keeps its own substep size, as long as
+         * the number of instances does not change.  A different number of
+         * instances allocates memory, see setNrOfInstances().
+         *
+         * @param q joint positions, nj x N, updated
+         * @param q_dot joint velocities, nj x N, updated
+         * @param torques joint torques, nj x N
+         * @param dt the time step
+         * @return the error of the first instance that failed
+         */
+        int step(Eigen::MatrixXd& q, Eigen::MatrixXd& q_dot, const Eigen::MatrixXd& torques, double dt);
+
+        /// Number of (accepted) substeps of the last call of the JntArray version of step().
+        unsigned int getLastNrOfSubsteps() const { return last_nr_of_substeps; }
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+    private:
+        // workspace of one thread
+        struct Workspace
+        {
+            Workspace(const ChainConstPtr& chain, const Vector& grav);
+            void resize(std::size_t nj);
+            ChainFdSolver_ABA fdsolver;
+            JntArray q;
+            JntArray q_dot;
+            JntArray torques;
+            JntArray q_stage;
+            JntArray q_dot_stage;
+            JntArray q_dotdot;
+            Eigen::MatrixXd k_q;        // derivatives of the positions at the stages
+            Eigen::MatrixXd k_q_dot;    // derivatives of the velocities at the stages
+        };
+
+        int integrate(Workspace& ws, const Wrenches* f_ext, double dt, double& h_next, unsigned int& nr_of_substeps) const;
+        int stages(Workspace& ws, const Wrenches* f_ext, int nr_of_stages, const double (*a)[7], double h, bool first_valid) const;
+        int derivative(Workspace& ws, const Wrenches* f_ext) const;
+
+        const ChainConstPtr chain_ptr;
+        const Chain& chain;
+        std::size_t nj;
+        Method method;
+        double abs_tol;
+        double rel_tol;
+        unsigned int max_nr_of_substeps;
+        JointTorqueModelConstPtr torque_model;
+        bool default_torque_model;
+        ThreadPool pool;
+        std::vector<Workspace> workspaces;
+        double substep;     // RK45 substep size of the JntArray version of step()
+        unsigned int last_nr_of_substeps;
+        std::vector<double> substeps;   // RK45 substep sizes of the instances
+        std::vector<int> codes;
+    };
+}
+
+#endif
@@ -29,7 +29,6 @@ namespace KDL {
       name(_name),type(_type),scale(_scale),offset(_offset),inertia(_inertia),damping(_damping),stiffness(_stiffness),upper_position_limit(_upper_position_limit),lower_position_limit(_lower_position_limit),home_position(_home)
     {
       if (type == RotAxis || type == TransAxis) throw joint_type_ex;
-      q_previous = 0;
     }
 
     // constructor for joint along x,y or z axis, at origin of reference frame
@@ -38,7 +37,6 @@ namespace KDL {
       name("NoName"),type(_type),scale(_scale),offset(_offset),inertia(_inertia),damping(_damping),stiffness(_stiffness),upper_position_limit(_upper_position_limit),lower_position_limit(_lower_position_limit),home_position(_home)
     {
       if (type == RotAxis || type == TransAxis) throw joint_type_ex;
-      q_previous = 0;
     }
 
     // constructor for joint along arbitrary axis, at arbitrary origin
@@ -48,11 +46,6 @@ namespace KDL {
       , axis(_axis / _axis.Norm()), origin(_origin)
     {
       if (type != RotAxis && type != TransAxis) throw joint_type_ex;
-
-      // initialize
-      joint_pose.p = origin;
-      joint_pose.M = Rotation::Rot2(axis, offset);
-      q_previous = 0;
     }
 
     // constructor for joint along arbitrary axis, at arbitrary origin
@@ -62,11 +55,6 @@ namespace KDL {
           axis(_axis / _axis.Norm()),origin(_origin)
     {
       if (type != RotAxis && type != TransAxis) throw joint_type_ex;
-
-      // initialize
-      joint_pose.p = origin;
-      joint_pose.M = Rotation::Rot2(axis, offset);
-      q_previous = 0;
     }
 
     Joint::~Joint()
@@ -77,12 +65,9 @@ namespace KDL {
     {
         switch(type){
         case RotAxis:
-            // calculate the rotation matrix around the vector "axis"
-            if (q != q_previous){
-                q_previous = q;
-                joint_pose.M = Rotation::Rot2(axis, scale*q+offset);
-            }
-            return joint_pose;
+            // calculate the rotation matrix around the vector "axis",
+            // no state is cached so that a Joint can be shared between threads
+            return Frame(Rotation::Rot2(axis, scale*q+offset), origin);
         case RotX:
             return Frame(Rotation::RotX(scale*q+offset));
         case RotY:
@@ -230,8 +230,6 @@ namespace KDL {
 
         // variables for RotAxis joint
         Vector axis, origin;
-        mutable Frame  joint_pose;
-        mutable double q_previous;
 
 
 
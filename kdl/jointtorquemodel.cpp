@@ -0,0 +1,143 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "jointtorquemodel.hpp"
+#include "solveri.hpp"
+
+namespace KDL
+{
+    JointTorqueModel::~JointTorqueModel()
+    {
+    }
+
+    int JointTorqueModel::JntToTorqueDerivatives(const JntArray& /*q*/, const JntArray& /*q_dot*/, JntArray& /*torques*/,
+                                                 Eigen::MatrixXd& /*dtorques_dq*/, Eigen::MatrixXd& /*dtorques_dqdot*/) const
+    {
+        return SolverI::E_NOT_IMPLEMENTED;
+    }
+
+    JointFrictionModel::JointFrictionModel(const Chain& chain) :
+        nj(chain.getNrOfJoints()),
+        damping(nj), stiffness(nj),
+        coulomb(nj), static_friction(nj), stribeck_velocity(nj),
+        smoothing_velocity(0.0), has_friction(false)
+    {
+        std::size_t j=0;
+        for(std::size_t i=0;i<chain.getNrOfSegments();i++){
+            const Joint& joint=chain.getSegment(i).getJoint();
+            if(joint.getType()!=Joint::Fixed){
+                damping(j)=joint.getDamping();
+                stiffness(j)=joint.getStiffness();
+                j++;
+            }
+        }
+        stribeck_velocity.data.setOnes();
+    }
+
+    JointFrictionModel::~JointFrictionModel()
+    {
+    }
+
+    int JointFrictionModel::setFriction(const JntArray& _coulomb, const JntArray& _static_friction,
+                                        const JntArray& _stribeck_velocity, double _smoothing_velocity)
+    {
+        if(_coulomb.rows()!=nj || _static_friction.rows()!=nj || _stribeck_velocity.rows()!=nj)
+            return SolverI::E_SIZE_MISMATCH;
+        if(!(_stribeck_velocity.data.array()>0.0).all() || !(_smoothing_velocity>=0.0))
+            return SolverI::E_OUT_OF_RANGE;
+        coulomb=_coulomb;
+        static_friction=_static_friction;
+        stribeck_velocity=_stribeck_velocity;
+        smoothing_velocity=_smoothing_velocity;
+        has_friction=true;
+        return SolverI::E_NOERROR;
+    }
+
+    int JointFrictionModel::setFriction(const JntArray& _coulomb, double _smoothing_velocity)
+    {
+        JntArray velocity(nj);
+        velocity.data.setOnes();
+        return setFriction(_coulomb, _coulomb, velocity, _smoothing_velocity);
+    }
+
+    int JointFrictionModel::JntToTorque(const JntArray& q, const JntArray& q_dot, JntArray& torques) const
+    {
+        if(q.rows()!=nj || q_dot.rows()!=nj || torques.rows()!=nj)
+            return SolverI::E_SIZE_MISMATCH;
+        const int rc=friction(q_dot, torques, NULL);
+        if(rc < 0)
+            return rc;
+        torques.data+=damping.data.cwiseProduct(q_dot.data);
+        torques.data+=stiffness.data.cwiseProduct(q.data);
+        torques.data=-torques.data;
+        return SolverI::E_NOERROR;
+    }
+
+    int JointFrictionModel::JntToTorqueDerivatives(const JntArray& q, const JntArray& q_dot, JntArray& torques,
+                                                   Eigen::MatrixXd& dtorques_dq, Eigen::MatrixXd& dtorques_dqdot) const
+    {
+        if(q.rows()!=nj || q_dot.rows()!=nj || torques.rows()!=nj ||
+           (std::size_t)dtorques_dq.rows()!=nj || (std::size_t)dtorques_dq.cols()!=nj ||
+           (std::size_t)dtorques_dqdot.rows()!=nj || (std::size_t)dtorques_dqdot.cols()!=nj)
+            return SolverI::E_SIZE_MISMATCH;
+        if(nj==0)
+            return SolverI::E_NOERROR;
+        //the joints are independent: the derivatives are diagonal, the
+        //friction derivatives are collected in the first column first
+        dtorques_dqdot.setZero();
+        const int rc=friction(q_dot, torques, dtorques_dqdot.col(0).data());
+        if(rc < 0)
+            return rc;
+        for(std::size_t i=nj;i-->1;){
+            dtorques_dqdot(i,i)=-(dtorques_dqdot(i,0)+damping(i));
+            dtorques_dqdot(i,0)=0.0;
+        }
+        dtorques_dqdot(0,0)=-(dtorques_dqdot(0,0)+damping(0));
+        dtorques_dq.setZero();
+        dtorques_dq.diagonal()=-stiffness.data;
+        torques.data+=damping.data.cwiseProduct(q_dot.data);
+        torques.data+=stiffness.data.cwiseProduct(q.data);
+        torques.data=-torques.data;
+        return SolverI::E_NOERROR;
+    }
+
+    int JointFrictionModel::friction(const JntArray& q_dot, JntArray& f, double* df) const
+    {
+        if(!has_friction){
+            f.data.setZero();
+            if(df)
+                Eigen::VectorXd::Map(df, nj).setZero();
+            return SolverI::E_NOERROR;
+        }
+        const Eigen::ArrayWrapper<const Eigen::VectorXd> v=q_dot.data.array();
+        const Eigen::ArrayWrapper<const Eigen::VectorXd> vs=stribeck_velocity.data.array();
+        //f = g(v) s(v), with the Stribeck curve g and the (smoothed) sign s
+        f.data.array()=coulomb.data.array()+(static_friction.data-coulomb.data).array()*(-(v/vs).square()).exp();
+        if(df){
+            Eigen::Map<Eigen::ArrayXd> d(df, nj);
+            d=-2.0*(static_friction.data-coulomb.data).array()*(-(v/vs).square()).exp()*v/vs.square();
+            if(smoothing_velocity>0.0)
+                d=d*(v/smoothing_velocity).tanh()+f.data.array()*(1.0-(v/smoothing_velocity).tanh().square())/smoothing_velocity;
+            else
+                d*=v.sign();
+        }
+        if(smoothing_velocity>0.0)
+            f.data.array()*=(v/smoothing_velocity).tanh();
+        else
+            f.data.array()*=v.sign();
+        return SolverI::E_NOERROR;
+    }
+}
@@ -0,0 +1,157 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_JOINTTORQUEMODEL_HPP
+#define KDL_JOINTTORQUEMODEL_HPP
+
+#include "chain.hpp"
+#include "jntarray.hpp"
+
+#include <Eigen/Core>
+#include <memory>
+
+namespace KDL
+{
+    /**
+     * \brief Interface of the passive torques of the joints: friction,
+     * damping, elasticity.
+     *
+     * The passive torques act on the joints in addition to the applied
+     * torques, so the equation of motion of a chain becomes
+     * \f$ H \ddot q + C + G = \tau + \tau_p(q, \dot q) \f$.
+     * ChainIdSolver_RNE subtracts them from the torques it returns,
+     * ChainFdSolver_ABA and ChainFdSolver_RNE add them to the applied
+     * torques.  The solvers evaluate the model once per call, for all the
+     * joints together, into a workspace they own.
+     *
+     * A model is shared between solvers and threads, JntToTorque() must
+     * not change its state.
+     */
+    class JointTorqueModel
+    {
+    public:
+        virtual ~JointTorqueModel();
+
+        /**
+         * Calculates the passive torques of the joints.
+         *
+         * @param q joint positions
+         * @param q_dot joint velocities
+         * @param torques output passive torques, must not allocate memory
+         * @return a SolverI error code, E_SIZE_MISMATCH if the sizes of
+         * the arguments do not match the model
+         */
+        virtual int JntToTorque(const JntArray& q, const JntArray& q_dot, JntArray& torques) const = 0;
+
+        /**
+         * Calculates the passive torques and their partial derivatives,
+         * for ChainFdSolver_Derivatives.
+         *
+         * @param q joint positions
+         * @param q_dot joint velocities
+         * @param torques output passive torques
+         * @param dtorques_dq nj x nj matrix, element (i,k) is d torques(i) / d q(k)
+         * @param dtorques_dqdot nj x nj matrix, element (i,k) is d torques(i) / d q_dot(k)
+         * @return E_NOT_IMPLEMENTED (the default) if the model has no
+         * derivatives
+         */
+        virtual int JntToTorqueDerivatives(const JntArray& q, const JntArray& q_dot, JntArray& torques,
+                                           Eigen::MatrixXd& dtorques_dq, Eigen::MatrixXd& dtorques_dqdot) const;
+    };
+
+    typedef std::shared_ptr<const JointTorqueModel> JointTorqueModelConstPtr;
+
+    /**
+     * \brief Damping, stiffness and friction of the joints.
+     *
+     * The passive torque of a joint is
+     * \f$ \tau_p = -d \dot q - k q - f(\dot q) \f$, with the damping d and
+     * the stiffness k of the Joint (the spring is relaxed at q = 0, as in
+     * ChainSimulator).  The friction f is zero unless set with setFriction(),
+     * by default it follows the Stribeck curve
+     * \f[ f(\dot q) = \left(F_c + (F_s - F_c)\, e^{-(\dot q / v_s)^2}\right)
+     * \mathrm{sgn}(\dot q) \f]
+     * with the Coulomb friction F_c, the static friction F_s and the
+     * Stribeck velocity v_s.  The sign is smoothed to
+     * \f$ \tanh(\dot q / v_\epsilon) \f$ when a smoothing velocity is set,
+     * which suits integrators better.
+     *
+     * Another friction curve is obtained by overriding friction(), which
+     * is used whether setFriction() was called or not; the damping and
+     * stiffness of the joints are kept.
+     */
+    class JointFrictionModel : public JointTorqueModel
+    {
+    public:
+        /**
+         * Reads the damping and the stiffness of the joints of \a chain.
+         */
+        explicit JointFrictionModel(const Chain& chain);
+        virtual ~JointFrictionModel();
+
+        /**
+         * Sets the Stribeck friction of the joints.
+         *
+         * @param coulomb Coulomb friction F_c of the joints
+         * @param static_friction static friction F_s of the joints
+         * @param stribeck_velocity Stribeck velocity v_s of the joints, positive
+         * @param smoothing_velocity v_eps of the smoothed sign, 0 for the exact sign
+         * @return E_SIZE_MISMATCH if the sizes do not match the number of
+         * joints, E_OUT_OF_RANGE if a velocity is not positive
+         */
+        int setFriction(const JntArray& coulomb, const JntArray& static_friction, const JntArray& stribeck_velocity,
+                        double smoothing_velocity=0.0);
+
+        /**
+         * Sets Coulomb friction only, without Stribeck effect.
+         */
+        int setFriction(const JntArray& coulomb, double smoothing_velocity=0.0);
+
+        const JntArray& getDamping() const { return damping; }
+        const JntArray& getStiffness() const { return stiffness; }
+
+        virtual int JntToTorque(const JntArray& q, const JntArray& q_dot, JntArray& torques) const;
+
+        virtual int JntToTorqueDerivatives(const JntArray& q, const JntArray& q_dot, JntArray& torques,
+                                           Eigen::MatrixXd& dtorques_dq, Eigen::MatrixXd& dtorques_dqdot) const;
+
+    protected:
+        /**
+         * Calculates the friction f of the joints, with the sign of the
+         * velocities, for all the joints at once.  The default is the
+         * Stribeck curve of setFriction(), zero before it is called.  The
+         * derivative of the exact sign is taken as zero.
+         *
+         * @param q_dot joint velocities
+         * @param f output friction, sized as q_dot
+         * @param df if not NULL, receives the nj derivatives df/dq_dot
+         * @return a SolverI error code, E_NOT_IMPLEMENTED if \a df is
+         * asked for and not available
+         */
+        virtual int friction(const JntArray& q_dot, JntArray& f, double* df) const;
+
+        std::size_t nj;
+        JntArray damping;
+        JntArray stiffness;
+        JntArray coulomb;
+        JntArray static_friction;
+        JntArray stribeck_velocity;
+        double smoothing_velocity;
+        bool has_friction;
+    };
+}
+
+#endif
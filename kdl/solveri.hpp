@@ -17,6 +17,27 @@
 #ifndef	__SOLVERI_HPP
 #define	__SOLVERI_HPP
 
+#ifdef KDL_SOLVER_TELEMETRY
+#include "utilities/solver_telemetry.hpp"
+
+/**
+ * Records the call of the enclosing solver function in the telemetry of
+ * the solver: put it first in a function that sets \a error on every
+ * return.
+ */
+#define KDL_SOLVER_TELEMETRY_SCOPE() \
+    ::KDL::SolverTelemetry::Scope kdl_solver_telemetry_scope(telemetry, error)
+/**
+ * Same as KDL_SOLVER_TELEMETRY_SCOPE, \a iterations names a counter of
+ * iterations, read when the function returns.
+ */
+#define KDL_SOLVER_TELEMETRY_SCOPE_ITER(iterations) \
+    ::KDL::SolverTelemetry::Scope kdl_solver_telemetry_scope(telemetry, error, iterations)
+#else
+#define KDL_SOLVER_TELEMETRY_SCOPE() ((void)0)
+#define KDL_SOLVER_TELEMETRY_SCOPE_ITER(iterations) ((void)0)
+#endif
+
 namespace KDL {
 
 /**
@@ -104,7 +125,9 @@ public:
     //! Not yet implemented
         E_NOT_IMPLEMENTED = -7,
     //! Internal svd calculation failed
-        E_SVD_FAILED = -8
+        E_SVD_FAILED = -8,
+    //! The time budget was exceeded before convergence
+        E_TIMEOUT = -9
     };
 
 	/// Initialize latest error to E_NOERROR
@@ -134,6 +157,7 @@ public:
 		else if (E_OUT_OF_RANGE == err) return "The requested index is out of range";
 		else if (E_NOT_IMPLEMENTED == err) return "The requested function is not yet implemented";
 		else  if (E_SVD_FAILED == err) return "SVD failed";
+		else if (E_TIMEOUT == err) return "The time budget is exceeded";
 		else return "UNKNOWN ERROR";
 	}
 
@@ -144,9 +168,21 @@ public:
 	 */
 	virtual void updateInternalDataStructures() = 0;
 
+#ifdef KDL_SOLVER_TELEMETRY
+	/// Return the statistics of the calls of this solver, safe to read from any thread.
+	/// Calls of the const overloads taking a workspace are not included.
+	const SolverTelemetry& getTelemetry() const { return telemetry; }
+	/// Clear the statistics of the calls of this solver
+	void resetTelemetry() { telemetry.reset(); }
+#endif
+
 protected:
 	/// Latest error, initialized to E_NOERROR in constructor
 	int		error;
+#ifdef KDL_SOLVER_TELEMETRY
+	/// Statistics of the calls, see KDL_SOLVER_TELEMETRY_SCOPE
+	SolverTelemetry telemetry;
+#endif
 };
 
 }	//	namespaces
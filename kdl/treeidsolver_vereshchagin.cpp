@@ -0,0 +1,386 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "treeidsolver_vereshchagin.hpp"
+#include "utilities/svd_eigen_HH.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace KDL
+{
+    namespace
+    {
+        typedef Eigen::Map<const Eigen::Matrix<double,3,3,Eigen::RowMajor> > RotationMap;
+
+        Eigen::Matrix<double,6,1> toVector(const Twist& t)
+        {
+            Eigen::Matrix<double,6,1> v;
+            v << t.vel.x(), t.vel.y(), t.vel.z(), t.rot.x(), t.rot.y(), t.rot.z();
+            return v;
+        }
+
+        Eigen::Matrix<double,6,1> toVector(const Wrench& w)
+        {
+            Eigen::Matrix<double,6,1> v;
+            v << w.force.x(), w.force.y(), w.force.z(), w.torque.x(), w.torque.y(), w.torque.z();
+            return v;
+        }
+    }
+
+    TreeIdSolver_Vereshchagin::TreeIdSolver_Vereshchagin(const Tree& tree, Twist root_acc,
+                                                         const std::vector<std::string>& constrained_segments,
+                                                         const std::vector<unsigned int>& nr_of_constraints,
+                                                         std::size_t nr_of_threads):
+        nj(tree.getNrOfJoints()), ns(tree.getNrOfSegments()), nc(0), acc_root(root_acc), valid(true),
+        trunk_end(0), pool(nr_of_threads)
+    {
+        //Depth first ordering of the segments, the children in the order
+        //they were added to the tree
+        std::vector<std::pair<SegmentMap::const_iterator,int> > stack;
+        const SegmentMap::const_iterator root = tree.getRootSegment();
+        for (std::size_t k = GetTreeElementChildren(root->second).size(); k > 0; k--)
+            stack.push_back(std::make_pair(GetTreeElementChildren(root->second)[k - 1], -1));
+        while (!stack.empty())
+        {
+            const SegmentMap::const_iterator element = stack.back().first;
+            parent.push_back(stack.back().second);
+            stack.pop_back();
+            const Segment& segment = GetTreeElementSegment(element->second);
+            segments.push_back(segment);
+            names.push_back(element->first);
+            q_nr.push_back(segment.getJoint().getType() != Joint::Fixed ? (int)GetTreeElementQNr(element->second) : -1);
+            const std::vector<SegmentMap::const_iterator>& element_children = GetTreeElementChildren(element->second);
+            for (std::size_t k = element_children.size(); k > 0; k--)
+                stack.push_back(std::make_pair(element_children[k - 1], (int)segments.size() - 1));
+        }
+
+        //Children of every segment, the root at index ns
+        std::vector<std::size_t> first(ns + 2, 0);
+        for (std::size_t i = 0; i < ns; i++)
+            first[(parent[i] < 0 ? ns : parent[i]) + 1]++;
+        for (std::size_t i = 0; i <= ns; i++)
+            first[i + 1] += first[i];
+        children.resize(ns);
+        std::vector<std::size_t> next(first.begin(), first.end() - 1);
+        for (std::size_t i = 0; i < ns; i++)
+            children[next[parent[i] < 0 ? ns : parent[i]]++] = i;
+        child_begin.assign(first.begin(), first.begin() + ns);
+        child_end.assign(first.begin() + 1, first.begin() + ns + 1);
+        root_child_begin = first[ns];
+        root_child_end = first[ns + 1];
+
+        //The subtree of i is [i, subtree_end[i])
+        std::vector<std::size_t> subtree_end(ns);
+        for (std::size_t i = ns; i > 0; i--)
+            subtree_end[i - 1] = child_end[i - 1] > child_begin[i - 1] ? subtree_end[children[child_end[i - 1] - 1]] : i;
+
+        //Constraint sets of every segment, in the order they were given
+        const std::size_t nr_of_sets = constrained_segments.size();
+        if (nr_of_constraints.size() != nr_of_sets)
+            valid = false;
+        std::vector<std::size_t> set_segment(nr_of_sets);
+        for (std::size_t k = 0; k < nr_of_sets; k++)
+        {
+            const std::vector<std::string>::const_iterator it = std::find(names.begin(), names.end(), constrained_segments[k]);
+            if (it == names.end())
+                valid = false;
+            set_segment[k] = it - names.begin();
+        }
+        set_size = valid ? nr_of_constraints : std::vector<unsigned int>(nr_of_sets, 0);
+        set_col.resize(nr_of_sets);
+        for (std::size_t k = 0; k < nr_of_sets; k++)
+            sets.push_back(k);
+        std::stable_sort(sets.begin(), sets.end(), [&](std::size_t l, std::size_t r) { return set_segment[l] < set_segment[r]; });
+        set_begin.resize(ns);
+        set_end.resize(ns);
+        col_begin.resize(ns);
+        col_count.resize(ns);
+        std::size_t s = 0;
+        for (std::size_t i = 0; i < ns; i++)
+        {
+            col_begin[i] = nc;
+            set_begin[i] = s;
+            for (; s < nr_of_sets && set_segment[sets[s]] == i; s++)
+            {
+                set_col[sets[s]] = nc;
+                nc += set_size[sets[s]];
+            }
+            set_end[i] = s;
+        }
+        for (std::size_t i = 0; i < ns; i++)
+            col_count[i] = (subtree_end[i] < ns ? col_begin[subtree_end[i]] : nc) - col_begin[i];
+
+        //Trunk and branches
+        std::size_t branches_begin = root_child_begin, branches_end = root_child_end;
+        while (branches_end - branches_begin == 1)
+        {
+            trunk_end = children[branches_begin] + 1;
+            branches_begin = child_begin[trunk_end - 1];
+            branches_end = child_end[trunk_end - 1];
+        }
+        if (branches_end == branches_begin)
+            trunk_end = ns;
+        for (std::size_t k = branches_begin; k < branches_end; k++)
+        {
+            branch_begin.push_back(children[k]);
+            branch_end.push_back(subtree_end[children[k]]);
+        }
+        codes.resize(branch_begin.size());
+
+        F.resize(ns);
+        F_base.resize(ns);
+        v.resize(ns);
+        Z.resize(ns);
+        C.resize(ns);
+        a.resize(ns);
+        U.resize(ns);
+        R.resize(ns);
+        PZ.resize(ns);
+        PC.resize(ns);
+        P.resize(ns);
+        D.resize(ns);
+        u.resize(ns);
+        E.resize(ns);
+        EZ.resize(ns);
+        for (std::size_t i = 0; i < ns; i++)
+        {
+            E[i].resize(6, col_count[i]);
+            EZ[i].resize(col_count[i]);
+        }
+        E_base.resize(6, nc);
+        M_base.resize(nc, nc);
+        G_base.resize(nc);
+        beta_all.resize(nc);
+        nu_sum.resize(nc);
+        nu_tmp.resize(nc);
+        nu.resize(nc);
+        Um.resize(nc, nc);
+        Vm.resize(nc, nc);
+        Sm.resize(nc);
+        tmpm.resize(nc);
+    }
+
+    TreeIdSolver_Vereshchagin::~TreeIdSolver_Vereshchagin()
+    {
+    }
+
+    void TreeIdSolver_Vereshchagin::updateInternalDataStructures()
+    {
+        //The segments are copied at construction, nothing to update
+    }
+
+    int TreeIdSolver_Vereshchagin::CartToJnt(const JntArray &q, const JntArray &q_dot, JntArray &q_dotdot,
+                                             const std::vector<Jacobian>& alfa, const std::vector<JntArray>& beta,
+                                             const WrenchMap& f_ext, JntArray &torques)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        if (!valid)
+            return (error = E_UNDEFINED);
+        if (q.rows() != nj || q_dot.rows() != nj || q_dotdot.rows() != nj || torques.rows() != nj)
+            return (error = E_SIZE_MISMATCH);
+        if (alfa.size() != set_size.size() || beta.size() != set_size.size())
+            return (error = E_SIZE_MISMATCH);
+        for (std::size_t k = 0; k < set_size.size(); k++)
+        {
+            if (alfa[k].columns() != set_size[k] || beta[k].rows() != set_size[k])
+                return (error = E_SIZE_MISMATCH);
+            beta_all.segment(set_col[k], set_size[k]) = beta[k].data;
+        }
+
+        M_base.setZero();
+        G_base.setZero();
+        const bool parallel = pool.size() > 1 && branch_begin.size() > 1;
+        if (parallel)
+        {
+            initialUpwardsSweep(0, trunk_end, q, q_dot, f_ext);
+            pool.parallel_for(branch_begin.size(), [&](std::size_t k, std::size_t) {
+                initialUpwardsSweep(branch_begin[k], branch_end[k], q, q_dot, f_ext);
+                codes[k] = downwardsSweep(branch_begin[k], branch_end[k], alfa, torques);
+            });
+            for (std::size_t k = 0; k < codes.size(); k++)
+                if (codes[k] != E_NOERROR)
+                    return (error = codes[k]);
+            error = downwardsSweep(0, trunk_end, alfa, torques);
+        }
+        else
+        {
+            initialUpwardsSweep(0, ns, q, q_dot, f_ext);
+            error = downwardsSweep(0, ns, alfa, torques);
+        }
+        if (error != E_NOERROR)
+            return error;
+
+        //The constraint forces at the base, from the children of the root
+        ArticulatedBodyInertia P_base;
+        Wrench R_base = Wrench::Zero();
+        E_base.setZero();
+        addChildren(root_child_begin, root_child_end, P_base, R_base, E_base, 0);
+        constraintCalculation();
+
+        if (parallel)
+        {
+            finalUpwardsSweep(0, trunk_end, q_dotdot, torques);
+            pool.parallel_for(branch_begin.size(), [&](std::size_t k, std::size_t) {
+                finalUpwardsSweep(branch_begin[k], branch_end[k], q_dotdot, torques);
+            });
+        }
+        else
+            finalUpwardsSweep(0, ns, q_dotdot, torques);
+        return (error = E_NOERROR);
+    }
+
+    void TreeIdSolver_Vereshchagin::initialUpwardsSweep(std::size_t begin, std::size_t end, const JntArray &q, const JntArray &q_dot, const WrenchMap& f_ext)
+    {
+        for (std::size_t i = begin; i < end; i++)
+        {
+            const Segment& segment = segments[i];
+            double q_ = 0.0, qdot_ = 0.0;
+            if (q_nr[i] >= 0)
+            {
+                q_ = q(q_nr[i]);
+                qdot_ = q_dot(q_nr[i]);
+            }
+            F[i] = segment.pose(q_);
+            F_base[i] = parent[i] < 0 ? F[i] : F_base[parent[i]] * F[i];
+
+            //joint velocity and unit twist in the segment frame, then Z in the joint root frame
+            const Twist vj = F[i].M.Inverse(segment.twist(q_, qdot_));
+            Z[i] = F[i] * F[i].M.Inverse(segment.twist(q_, 1.0));
+
+            v[i] = parent[i] < 0 ? vj : F[i].Inverse(v[parent[i]]) + vj;
+            C[i] = F[i] * (v[i] * vj);
+            U[i] = v[i] * (segment.getInertia() * v[i]);
+            const WrenchMap::const_iterator f = f_ext.find(names[i]);
+            if (f != f_ext.end())
+                U[i] = U[i] - F_base[i].M.Inverse() * f->second;
+        }
+    }
+
+    void TreeIdSolver_Vereshchagin::addChildren(std::size_t begin, std::size_t end, ArticulatedBodyInertia& P_tilde, Wrench& R_tilde,
+                                                Eigen::MatrixXd& E_tilde, int col_offset) const
+    {
+        for (std::size_t k = begin; k < end; k++)
+        {
+            const std::size_t c = children[k];
+            Eigen::Block<Eigen::MatrixXd, Eigen::Dynamic, Eigen::Dynamic, true> E_c = E_tilde.middleCols(col_begin[c] - col_offset, col_count[c]);
+            P_tilde = P_tilde + P[c];
+            R_tilde = R_tilde + R[c] + PC[c];
+            E_c += E[c];
+            if (q_nr[c] >= 0)
+            {
+                //equations a) to c) of Vereshchagin89
+                const double Dinv = 1.0 / D[c];
+                Eigen::Map<const Eigen::Vector3d> PZf(PZ[c].force.data), PZt(PZ[c].torque.data);
+                P_tilde.M.noalias() -= Dinv * PZf * PZf.transpose();
+                P_tilde.H.noalias() -= Dinv * PZt * PZf.transpose();
+                P_tilde.I.noalias() -= Dinv * PZt * PZt.transpose();
+                R_tilde += PZ[c] * (u[c] * Dinv);
+                E_c.noalias() -= Dinv * toVector(PZ[c]) * EZ[c].transpose();
+            }
+        }
+    }
+
+    int TreeIdSolver_Vereshchagin::downwardsSweep(std::size_t begin, std::size_t end, const std::vector<Jacobian>& alfa, const JntArray &torques)
+    {
+        for (std::size_t i = end; i-- > begin;)
+        {
+            const Segment& segment = segments[i];
+            Eigen::MatrixXd& E_i = E[i];
+            ArticulatedBodyInertia P_tilde(segment.getInertia());
+            Wrench R_tilde = U[i];
+
+            //The constraints of the segment, from the base frame to the segment frame
+            E_i.setZero();
+            RotationMap R_base(F_base[i].M.data);
+            for (std::size_t s = set_begin[i]; s < set_end[i]; s++)
+            {
+                const Eigen::Matrix<double, 6, Eigen::Dynamic>& alfa_s = alfa[sets[s]].data;
+                const unsigned int col = set_col[sets[s]] - col_begin[i];
+                for (unsigned int c = 0; c < set_size[sets[s]]; c++)
+                {
+                    E_i.col(col + c).head<3>().noalias() = R_base.transpose() * alfa_s.col(c).head<3>();
+                    E_i.col(col + c).tail<3>().noalias() = R_base.transpose() * alfa_s.col(c).tail<3>();
+                }
+            }
+            addChildren(child_begin[i], child_end[i], P_tilde, R_tilde, E_i, col_begin[i]);
+
+            //Transform to the joint root
+            P[i] = F[i] * P_tilde;
+            R[i] = F[i] * R_tilde;
+            for (unsigned int c = 0; c < col_count[i]; c++)
+            {
+                Wrench w(Vector(E_i(0, c), E_i(1, c), E_i(2, c)), Vector(E_i(3, c), E_i(4, c), E_i(5, c)));
+                w = F[i] * w;
+                E_i.col(c) << Eigen::Vector3d::Map(w.force.data), Eigen::Vector3d::Map(w.torque.data);
+            }
+            PC[i] = P[i] * C[i];
+
+            //equations d) and e) of Vereshchagin89, the constraints of the
+            //subtree only couple with each other
+            const unsigned int cb = col_begin[i], n = col_count[i];
+            if (q_nr[i] >= 0)
+            {
+                PZ[i] = P[i] * Z[i];
+                D[i] = dot(Z[i], PZ[i]);
+                if (!(D[i] > 0))
+                    return E_UNDEFINED;
+                u[i] = torques(q_nr[i]) - dot(Z[i], R[i] + PC[i]);
+                EZ[i].noalias() = E_i.transpose() * toVector(Z[i]);
+                const double Dinv = 1.0 / D[i];
+                M_base.block(cb, cb, n, n).noalias() -= Dinv * EZ[i] * EZ[i].transpose();
+                G_base.segment(cb, n).noalias() += E_i.transpose() * toVector(C[i] + Z[i] * (u[i] * Dinv));
+            }
+            else
+                G_base.segment(cb, n).noalias() += E_i.transpose() * toVector(C[i]);
+        }
+        return E_NOERROR;
+    }
+
+    void TreeIdSolver_Vereshchagin::constraintCalculation()
+    {
+        //equation f) nu = M_0^-1 (beta - E_0^T acc_root - G_0), with the
+        //truncated pseudo-inverse of M_0 as in ChainIdSolver_Vereshchagin
+        if (nc == 0)
+            return;
+        svd_eigen_HH(M_base, Um, Sm, Vm, tmpm);
+        nu_sum = beta_all - G_base;
+        nu_sum.noalias() -= E_base.transpose() * toVector(acc_root);
+        nu_tmp.noalias() = Um.transpose() * nu_sum;
+        for (unsigned int k = 0; k < nc; k++)
+            nu_tmp(k) = Sm(k) < 1e-14 ? 0.0 : nu_tmp(k) / Sm(k);
+        nu.noalias() = Vm * nu_tmp;
+    }
+
+    void TreeIdSolver_Vereshchagin::finalUpwardsSweep(std::size_t begin, std::size_t end, JntArray &q_dotdot, JntArray &torques)
+    {
+        //equation g) q_dotdot = D^-1 (u - Z^T (P a_parent + E nu))
+        for (std::size_t i = begin; i < end; i++)
+        {
+            const Twist& a_p = parent[i] < 0 ? acc_root : a[parent[i]];
+            if (q_nr[i] >= 0)
+            {
+                const int j = q_nr[i];
+                const double constraint_torque = -EZ[i].dot(nu.segment(col_begin[i], col_count[i]));
+                torques(j) = constraint_torque;
+                q_dotdot(j) = (u[i] - dot(Z[i], P[i] * a_p) + constraint_torque) / D[i];
+                a[i] = F[i].Inverse(a_p + Z[i] * q_dotdot(j) + C[i]);
+            }
+            else
+                a[i] = F[i].Inverse(a_p + C[i]);
+        }
+    }
+}
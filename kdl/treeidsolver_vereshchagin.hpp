@@ -0,0 +1,181 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_TREEIDSOLVER_VERESHCHAGIN_HPP
+#define KDL_TREEIDSOLVER_VERESHCHAGIN_HPP
+
+#include "tree.hpp"
+#include "jacobian.hpp"
+#include "jntarray.hpp"
+#include "articulatedbodyinertia.hpp"
+#include "solveri.hpp"
+#include "utilities/thread_pool.hpp"
+
+#include <Eigen/Core>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace KDL
+{
+    typedef std::map<std::string,Wrench> WrenchMap;
+
+    /**
+     * \brief Hybrid dynamics solver for trees with acceleration
+     * constraints on several segments, the tree version of
+     * ChainIdSolver_Vereshchagin.
+     *
+     * Every constrained segment, typically an end effector, has its own
+     * set of constraints, given in the same form as for
+     * ChainIdSolver_Vereshchagin: \a alfa holds the unit constraint forces
+     * at the tip of the segment as columns ordered (force; torque),
+     * expressed in the base frame, and \a beta the acceleration energies.
+     * f_ext is expressed in the base orientation, and the torques are the
+     * input joint torques on entry and the constraint torques on return.
+     *
+     * The segments are solved in a flat depth first ordering of the tree
+     * with three O(n) sweeps, and the constraint forces of all sets
+     * together with one dense solve of size equal to the total number of
+     * constraints.  The constraints of a subtree only couple with the
+     * constraints of another subtree through their common ancestors.
+     *
+     * The branches starting at the first segment with more than one child
+     * can be processed concurrently by the threads of a ThreadPool.  This
+     * only pays off for large trees: the threads synchronise twice per
+     * call.  Once constructed, the solver does not allocate memory.
+     *
+     * The joint numbers are those of the tree given to the constructor.
+     *
+     * @ingroup KinematicFamily
+     */
+    class TreeIdSolver_Vereshchagin : public SolverI
+    {
+    public:
+        /**
+         * @param tree the tree to calculate the dynamics for
+         * @param root_acc the acceleration of the root, most likely contains gravity
+         * @param constrained_segments names of the segments with a set of constraints
+         * @param nr_of_constraints number of constraints of every set
+         * @param nr_of_threads number of threads, including the calling
+         *        thread.  0 selects the number of hardware threads.
+         */
+        TreeIdSolver_Vereshchagin(const Tree& tree, Twist root_acc,
+                                  const std::vector<std::string>& constrained_segments,
+                                  const std::vector<unsigned int>& nr_of_constraints,
+                                  std::size_t nr_of_threads=1);
+        ~TreeIdSolver_Vereshchagin();
+
+        /**
+         * Calculates the joint accelerations and the constraint torques,
+         * see ChainIdSolver_Vereshchagin::CartToJnt.
+         *
+         * @param alfa unit constraint forces, one 6 x nc Jacobian per set
+         * @param beta acceleration energies, one vector of size nc per set
+         * @param f_ext external forces on the segments by name, missing
+         *        segments have no external force
+         * @return E_UNDEFINED if a constrained segment is not in the tree
+         * or a joint moves no mass, E_SIZE_MISMATCH if the sizes of the
+         * arguments do not match
+         */
+        int CartToJnt(const JntArray &q, const JntArray &q_dot, JntArray &q_dotdot,
+                      const std::vector<Jacobian>& alfa, const std::vector<JntArray>& beta,
+                      const WrenchMap& f_ext, JntArray &torques);
+
+        /// Total number of constraints of all sets.
+        unsigned int getNrOfConstraints() const { return nc; }
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+    private:
+        void initialUpwardsSweep(std::size_t begin, std::size_t end, const JntArray &q, const JntArray &q_dot, const WrenchMap& f_ext);
+        int downwardsSweep(std::size_t begin, std::size_t end, const std::vector<Jacobian>& alfa, const JntArray &torques);
+        void constraintCalculation();
+        void finalUpwardsSweep(std::size_t begin, std::size_t end, JntArray &q_dotdot, JntArray &torques);
+        void addChildren(std::size_t begin, std::size_t end, ArticulatedBodyInertia& P_tilde, Wrench& R_tilde,
+                         Eigen::MatrixXd& E_tilde, int col_offset) const;
+
+        std::size_t nj;
+        std::size_t ns;
+        unsigned int nc;
+        Twist acc_root;
+        bool valid;
+
+        // Segments in depth first order: a parent comes before its
+        // children and every subtree is a contiguous range
+        std::vector<Segment> segments;
+        std::vector<std::string> names;
+        std::vector<int> parent;                // -1 for the children of the root
+        std::vector<int> q_nr;                  // -1 for fixed joints
+        std::vector<std::size_t> child_begin;   // children in [child_begin, child_end) of children
+        std::vector<std::size_t> child_end;
+        std::vector<std::size_t> children;
+        std::size_t root_child_begin;
+        std::size_t root_child_end;
+        // The constraints are numbered in the same order: the constraints
+        // of a subtree are [col_begin, col_begin + col_count)
+        std::vector<unsigned int> col_begin;
+        std::vector<unsigned int> col_count;
+        std::vector<std::size_t> set_begin;     // sets of a segment in [set_begin, set_end) of sets
+        std::vector<std::size_t> set_end;
+        std::vector<std::size_t> sets;
+        std::vector<unsigned int> set_size;
+        std::vector<unsigned int> set_col;      // first constraint of a set
+
+        // The trunk [0, trunk_end) ends at the first segment with more
+        // than one child, the branches are the subtrees of its children
+        std::size_t trunk_end;
+        std::vector<std::size_t> branch_begin;
+        std::vector<std::size_t> branch_end;
+
+        // Per segment, Z, C, P, PZ, PC, R and E are expressed in the tip
+        // frame of the parent (the joint root), the others in the segment frame
+        std::vector<Frame> F;
+        std::vector<Frame> F_base;
+        std::vector<Twist> v;
+        std::vector<Twist> Z;
+        std::vector<Twist> C;
+        std::vector<Twist> a;
+        std::vector<Wrench> U;
+        std::vector<Wrench> R;
+        std::vector<Wrench> PZ;
+        std::vector<Wrench> PC;
+        std::vector<ArticulatedBodyInertia> P;
+        std::vector<double> D;
+        std::vector<double> u;
+        std::vector<Eigen::MatrixXd> E;
+        std::vector<Eigen::VectorXd> EZ;
+
+        // constraint quantities of the base
+        Eigen::MatrixXd E_base;
+        Eigen::MatrixXd M_base;
+        Eigen::VectorXd G_base;
+        Eigen::VectorXd beta_all;
+        Eigen::VectorXd nu_sum;
+        Eigen::VectorXd nu_tmp;
+        Eigen::VectorXd nu;
+        // SVD of M_base, see svd_eigen_HH
+        Eigen::MatrixXd Um;
+        Eigen::MatrixXd Vm;
+        Eigen::VectorXd Sm;
+        Eigen::VectorXd tmpm;
+
+        ThreadPool pool;
+        std::vector<int> codes;
+    };
+}
+
+#endif
@@ -0,0 +1,124 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "treejnttocomsolver.hpp"
+
+namespace KDL
+{
+    TreeJntToComSolver::TreeJntToComSolver(const Tree& tree):
+        nj(tree.getNrOfJoints()), ns(tree.getNrOfSegments())
+    {
+        //Depth first ordering of the segments
+        std::vector<std::pair<SegmentMap::const_iterator,int> > stack;
+        const SegmentMap::const_iterator root = tree.getRootSegment();
+        for(std::size_t k = GetTreeElementChildren(root->second).size(); k > 0; k--)
+            stack.push_back(std::make_pair(GetTreeElementChildren(root->second)[k - 1], -1));
+        while(!stack.empty()){
+            const SegmentMap::const_iterator element = stack.back().first;
+            parent.push_back(stack.back().second);
+            stack.pop_back();
+            const Segment& segment = GetTreeElementSegment(element->second);
+            segments.push_back(segment);
+            q_nr.push_back(segment.getJoint().getType() != Joint::Fixed ? (int)GetTreeElementQNr(element->second) : -1);
+            const std::vector<SegmentMap::const_iterator>& element_children = GetTreeElementChildren(element->second);
+            for(std::size_t k = element_children.size(); k > 0; k--)
+                stack.push_back(std::make_pair(element_children[k - 1], (int)segments.size() - 1));
+        }
+        T_base.resize(ns);
+        I_base.resize(ns);
+        S_base.resize(ns);
+    }
+
+    TreeJntToComSolver::~TreeJntToComSolver()
+    {
+    }
+
+    void TreeJntToComSolver::updateInternalDataStructures()
+    {
+        //The segments are copied at construction, nothing to update
+    }
+
+    int TreeJntToComSolver::JntToCoM(const JntArray& q, double& mass, Vector& com)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        if(q.rows()!=nj)
+            return (error = E_SIZE_MISMATCH);
+
+        RigidBodyInertia I_total;
+        for(std::size_t i=0;i<ns;i++){
+            const Frame X=segments[i].pose(q_nr[i]>=0 ? q(q_nr[i]) : 0.0);
+            T_base[i]=parent[i]<0 ? X : T_base[parent[i]]*X;
+            I_total=I_total+T_base[i]*segments[i].getInertia();
+        }
+        mass=I_total.getMass();
+        com=I_total.getCOG();
+        return (error = E_NOERROR);
+    }
+
+    int TreeJntToComSolver::JntToCentroidal(const JntArray& q, double& mass, Vector& com, Eigen::MatrixXd& com_jac, Eigen::MatrixXd& cmm)
+    {
+        KDL_SOLVER_TELEMETRY_SCOPE();
+        if(q.rows()!=nj || com_jac.rows()!=3 || (std::size_t)com_jac.cols()!=nj ||
+           cmm.rows()!=6 || (std::size_t)cmm.cols()!=nj)
+            return (error = E_SIZE_MISMATCH);
+
+        //Sweep from root to leaves: inertias and joint twists in the base
+        //frame, with reference point at the base origin
+        for(std::size_t i=0;i<ns;i++){
+            const Segment& segment=segments[i];
+            const double q_=q_nr[i]>=0 ? q(q_nr[i]) : 0.0;
+            const Frame X=segment.pose(q_);
+            if(parent[i]<0){
+                T_base[i]=X;
+                S_base[i]=segment.twist(q_,1.0).RefPoint(-X.p);
+            }else{
+                const Frame& T_parent=T_base[parent[i]];
+                T_base[i]=T_parent*X;
+                S_base[i]=(T_parent.M*segment.twist(q_,1.0)).RefPoint(-T_base[i].p);
+            }
+            I_base[i]=T_base[i]*segment.getInertia();
+        }
+
+        //Sweep from leaves to root: a subtree is complete when its root is
+        //reached, its momentum is the composite inertia times the unit
+        //twist of the joint
+        RigidBodyInertia I_total;
+        for(std::size_t i=ns;i-->0;){
+            if(q_nr[i]>=0){
+                const Wrench h=I_base[i]*S_base[i];
+                cmm.col(q_nr[i]) << Eigen::Vector3d::Map(h.force.data), Eigen::Vector3d::Map(h.torque.data);
+            }
+            if(parent[i]<0)
+                I_total=I_total+I_base[i];
+            else
+                I_base[parent[i]]=I_base[parent[i]]+I_base[i];
+        }
+
+        //Angular momentum about the center of mass
+        mass=I_total.getMass();
+        com=I_total.getCOG();
+        for(std::size_t k=0;k<nj;k++){
+            const Vector p(cmm(0,k),cmm(1,k),cmm(2,k));
+            const Vector p_x_com=p*com;
+            cmm.col(k).tail<3>()+=Eigen::Vector3d::Map(p_x_com.data);
+        }
+        if(mass>0)
+            com_jac=cmm.topRows<3>()/mass;
+        else
+            com_jac.setZero();
+        return (error = E_NOERROR);
+    }
+}
@@ -0,0 +1,96 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_TREEJNTTOCOMSOLVER_HPP
+#define KDL_TREEJNTTOCOMSOLVER_HPP
+
+#include "tree.hpp"
+#include "jntarray.hpp"
+#include "solveri.hpp"
+
+#include <Eigen/Core>
+
+namespace KDL
+{
+    /**
+     * \brief Computes the center of mass of a tree, its Jacobian and the
+     * centroidal momentum matrix, see ChainJntToComSolver.
+     *
+     * The segments are stored in a flat depth first ordering of the tree,
+     * in which a parent comes before its children.  The inertias of the
+     * segments are transformed to the base frame while the poses are
+     * propagated from the root to the leaves, and summed into the
+     * composite inertias of the subtrees from the leaves to the root.
+     * The momentum of the subtree beyond a joint moving at unit velocity
+     * is a column of the centroidal momentum matrix.
+     *
+     * Everything is expressed in the frame of the root.  The
+     * centroidal momentum matrix A gives the momentum
+     * \f$ A \dot q \f$ ordered (linear; angular), with the angular momentum
+     * about the center of mass.  The center of mass Jacobian is the
+     * linear part divided by the total mass.  The joint numbers are those
+     * of the tree given to the constructor.
+     *
+     * @ingroup KinematicFamily
+     */
+    class TreeJntToComSolver : public SolverI
+    {
+    public:
+        /**
+         * @param tree the tree to calculate the center of mass for
+         */
+        explicit TreeJntToComSolver(const Tree& tree);
+        virtual ~TreeJntToComSolver();
+
+        /**
+         * Calculates the total mass and the center of mass.
+         *
+         * @param q joint positions
+         * @param mass output total mass
+         * @param com output center of mass, zero if the tree has no mass
+         */
+        int JntToCoM(const JntArray& q, double& mass, Vector& com);
+
+        /**
+         * Calculates the total mass, the center of mass, its Jacobian
+         * and the centroidal momentum matrix.
+         *
+         * @param q joint positions
+         * @param mass output total mass
+         * @param com output center of mass
+         * @param com_jac output 3 x nj center of mass Jacobian, zero if
+         * the tree has no mass
+         * @param cmm output 6 x nj centroidal momentum matrix
+         */
+        int JntToCentroidal(const JntArray& q, double& mass, Vector& com, Eigen::MatrixXd& com_jac, Eigen::MatrixXd& cmm);
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+    private:
+        std::size_t nj;
+        std::size_t ns;
+        // Segments in depth first order
+        std::vector<Segment> segments;
+        std::vector<int> parent;                // -1 for the children of the root
+        std::vector<int> q_nr;                  // -1 for fixed joints
+        std::vector<Frame> T_base;              // pose of a segment in the base frame
+        std::vector<RigidBodyInertia> I_base;   // inertia of a segment, then of its subtree, in the base frame
+        std::vector<Twist> S_base;              // unit twist of a joint in the base frame
+    };
+}
+
+#endif
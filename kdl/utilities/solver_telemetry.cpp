@@ -0,0 +1,189 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "solver_telemetry.hpp"
+
+#include <bit>
+
+namespace KDL
+{
+    namespace
+    {
+        const std::memory_order relaxed = std::memory_order_relaxed;
+
+        void update_max(std::atomic<std::uint64_t>& max, std::uint64_t value)
+        {
+            std::uint64_t current = max.load(relaxed);
+            while (value > current && !max.compare_exchange_weak(current, value, relaxed))
+                ;
+        }
+    }
+
+    SolverTelemetry::Snapshot::Snapshot() :
+        nr_of_calls(0), total_latency(0), max_latency(0),
+        nr_of_iterated_calls(0), total_iterations(0), max_iterations(0)
+    {
+        latency_histogram.fill(0);
+        iteration_histogram.fill(0);
+        error_counts.fill(0);
+    }
+
+    std::uint64_t SolverTelemetry::Snapshot::getNrOfFailures() const
+    {
+        std::uint64_t n = 0;
+        for (int e = -MAX_ERROR_CODE; e < 0; ++e)
+            n += error_counts[errorBin(e)];
+        // the sign of the codes out of range is lost, they are not counted
+        return n;
+    }
+
+    double SolverTelemetry::Snapshot::getLatencyPercentile(double p) const
+    {
+        std::uint64_t total = 0;
+        for (std::size_t i = 0; i < NR_OF_LATENCY_BINS; ++i)
+            total += latency_histogram[i];
+        if (total == 0)
+            return 0;
+        const double target = p * static_cast<double>(total);
+        std::uint64_t n = 0;
+        for (std::size_t i = 0; i + 1 < NR_OF_LATENCY_BINS; ++i) {
+            n += latency_histogram[i];
+            if (static_cast<double>(n) >= target)
+                return static_cast<double>(std::uint64_t(1) << (i + 1));
+        }
+        return static_cast<double>(max_latency);
+    }
+
+    SolverTelemetry::Snapshot& SolverTelemetry::Snapshot::operator+=(const Snapshot& other)
+    {
+        nr_of_calls += other.nr_of_calls;
+        total_latency += other.total_latency;
+        if (other.max_latency > max_latency)
+            max_latency = other.max_latency;
+        nr_of_iterated_calls += other.nr_of_iterated_calls;
+        total_iterations += other.total_iterations;
+        if (other.max_iterations > max_iterations)
+            max_iterations = other.max_iterations;
+        for (std::size_t i = 0; i < NR_OF_LATENCY_BINS; ++i)
+            latency_histogram[i] += other.latency_histogram[i];
+        for (std::size_t i = 0; i < NR_OF_ITERATION_BINS; ++i)
+            iteration_histogram[i] += other.iteration_histogram[i];
+        for (std::size_t i = 0; i < NR_OF_ERROR_BINS; ++i)
+            error_counts[i] += other.error_counts[i];
+        return *this;
+    }
+
+    SolverTelemetry::Scope::~Scope()
+    {
+        const std::uint64_t latency = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        if (read_iterations)
+            telemetry.record(error, latency, read_iterations(iterations));
+        else
+            telemetry.record(error, latency);
+    }
+
+    SolverTelemetry::SolverTelemetry()
+    {
+        reset();
+    }
+
+    SolverTelemetry::SolverTelemetry(const SolverTelemetry&)
+    {
+        reset();
+    }
+
+    void SolverTelemetry::recordCall(int error, std::uint64_t latency)
+    {
+        nr_of_calls.fetch_add(1, relaxed);
+        total_latency.fetch_add(latency, relaxed);
+        update_max(max_latency, latency);
+        latency_histogram[latencyBin(latency)].fetch_add(1, relaxed);
+        error_counts[errorBin(error)].fetch_add(1, relaxed);
+    }
+
+    void SolverTelemetry::record(int error, std::uint64_t latency)
+    {
+        recordCall(error, latency);
+    }
+
+    void SolverTelemetry::record(int error, std::uint64_t latency, std::uint64_t iterations)
+    {
+        recordCall(error, latency);
+        nr_of_iterated_calls.fetch_add(1, relaxed);
+        total_iterations.fetch_add(iterations, relaxed);
+        update_max(max_iterations, iterations);
+        iteration_histogram[iterationBin(iterations)].fetch_add(1, relaxed);
+    }
+
+    void SolverTelemetry::snapshot(Snapshot& s) const
+    {
+        s.nr_of_calls = nr_of_calls.load(relaxed);
+        s.total_latency = total_latency.load(relaxed);
+        s.max_latency = max_latency.load(relaxed);
+        s.nr_of_iterated_calls = nr_of_iterated_calls.load(relaxed);
+        s.total_iterations = total_iterations.load(relaxed);
+        s.max_iterations = max_iterations.load(relaxed);
+        for (std::size_t i = 0; i < NR_OF_LATENCY_BINS; ++i)
+            s.latency_histogram[i] = latency_histogram[i].load(relaxed);
+        for (std::size_t i = 0; i < NR_OF_ITERATION_BINS; ++i)
+            s.iteration_histogram[i] = iteration_histogram[i].load(relaxed);
+        for (std::size_t i = 0; i < NR_OF_ERROR_BINS; ++i)
+            s.error_counts[i] = error_counts[i].load(relaxed);
+    }
+
+    SolverTelemetry::Snapshot SolverTelemetry::snapshot() const
+    {
+        Snapshot s;
+        snapshot(s);
+        return s;
+    }
+
+    void SolverTelemetry::reset()
+    {
+        nr_of_calls.store(0, relaxed);
+        total_latency.store(0, relaxed);
+        max_latency.store(0, relaxed);
+        nr_of_iterated_calls.store(0, relaxed);
+        total_iterations.store(0, relaxed);
+        max_iterations.store(0, relaxed);
+        for (Counter& c : latency_histogram)
+            c.store(0, relaxed);
+        for (Counter& c : iteration_histogram)
+            c.store(0, relaxed);
+        for (Counter& c : error_counts)
+            c.store(0, relaxed);
+    }
+
+    std::size_t SolverTelemetry::errorBin(int error)
+    {
+        if (error < -MAX_ERROR_CODE || error > MAX_ERROR_CODE)
+            return NR_OF_ERROR_BINS - 1;
+        return static_cast<std::size_t>(error + MAX_ERROR_CODE);
+    }
+
+    std::size_t SolverTelemetry::latencyBin(std::uint64_t latency)
+    {
+        const std::size_t bin = latency == 0 ? 0 : static_cast<std::size_t>(std::bit_width(latency)) - 1;
+        return bin < NR_OF_LATENCY_BINS ? bin : NR_OF_LATENCY_BINS - 1;
+    }
+
+    std::size_t SolverTelemetry::iterationBin(std::uint64_t iterations)
+    {
+        const std::size_t bin = static_cast<std::size_t>(std::bit_width(iterations));
+        return bin < NR_OF_ITERATION_BINS ? bin : NR_OF_ITERATION_BINS - 1;
+    }
+}
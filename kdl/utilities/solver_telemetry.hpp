@@ -0,0 +1,164 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_SOLVER_TELEMETRY_HPP
+#define KDL_SOLVER_TELEMETRY_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace KDL
+{
+    /**
+     * \brief Call statistics of a solver: number of calls, returned error
+     * codes, latency and number of iterations.
+     *
+     * When the library is built with the CMake option KDL_SOLVER_TELEMETRY,
+     * every SolverI holds one of these and the solvers record the calls of
+     * their non-const entry points in it, see SolverI::getTelemetry().  The
+     * const overloads that work on a caller-owned workspace (e.g. the
+     * position IK solvers, ChainFkSolverPos_recursive and
+     * ChainJntToJacSolver) leave the solver untouched and are not recorded;
+     * ChainIkSolverPos_Batch records the calls it makes through them.
+     *
+     * All counters are relaxed atomics: record() takes no lock, and
+     * snapshot() can be called from any thread (e.g. a monitoring thread)
+     * while the solver is running.  A snapshot is consistent per counter,
+     * not across counters: a call being recorded may be missing from some
+     * of them.
+     *
+     * Latencies are histogrammed in powers of two nanoseconds, the numbers
+     * of iterations in powers of two.
+     */
+    class SolverTelemetry
+    {
+    public:
+        /// Latency bin i counts the calls in [2^i, 2^(i+1)) ns (bin 0 includes 0, the last bin is open).
+        static const std::size_t NR_OF_LATENCY_BINS = 40;
+        /// Iteration bin 0 counts the calls that did not iterate, bin i > 0 those with [2^(i-1), 2^i) iterations (the last bin is open).
+        static const std::size_t NR_OF_ITERATION_BINS = 16;
+        /// Error codes in [-MAX_ERROR_CODE, MAX_ERROR_CODE] are counted separately, the others together.
+        static const int MAX_ERROR_CODE = 127;
+        static const std::size_t NR_OF_ERROR_BINS = 2*MAX_ERROR_CODE + 2;
+
+        /// Plain copy of the counters.
+        struct Snapshot
+        {
+            Snapshot();
+
+            /// Number of calls recorded.
+            std::uint64_t nr_of_calls;
+            /// Sum and maximum of the latencies, in nanoseconds.
+            std::uint64_t total_latency;
+            std::uint64_t max_latency;
+            /// Number of calls reporting a number of iterations, sum and maximum of these.
+            std::uint64_t nr_of_iterated_calls;
+            std::uint64_t total_iterations;
+            std::uint64_t max_iterations;
+
+            std::array<std::uint64_t, NR_OF_LATENCY_BINS> latency_histogram;
+            std::array<std::uint64_t, NR_OF_ITERATION_BINS> iteration_histogram;
+            /// Indexed with errorBin().
+            std::array<std::uint64_t, NR_OF_ERROR_BINS> error_counts;
+
+            /// Number of calls that returned \a error.
+            std::uint64_t getErrorCount(int error) const { return error_counts[errorBin(error)]; }
+            /// Number of calls that returned a negative (failure) code.
+            std::uint64_t getNrOfFailures() const;
+            /// Upper bound of the latency (ns) of the fraction \a p in [0, 1] of the fastest calls.
+            double getLatencyPercentile(double p) const;
+
+            /// Adds the counters of \a other, e.g. to aggregate several solver instances.
+            Snapshot& operator+=(const Snapshot& other);
+        };
+
+        /**
+         * Measures the latency of one solver call from its construction to
+         * its destruction, and records it with the value of \a error and,
+         * if given, of \a iterations at that time.  Use it through
+         * KDL_SOLVER_TELEMETRY_SCOPE or KDL_SOLVER_TELEMETRY_SCOPE_ITER,
+         * which read the error of the solver.
+         */
+        class Scope
+        {
+        public:
+            Scope(SolverTelemetry& telemetry, const int& error) :
+                telemetry(telemetry), error(error), iterations(nullptr), read_iterations(nullptr),
+                start(std::chrono::steady_clock::now())
+            {}
+
+            template<typename T>
+            Scope(SolverTelemetry& telemetry, const int& error, const T& iterations) :
+                telemetry(telemetry), error(error), iterations(&iterations),
+                read_iterations([](const void* p) { return static_cast<std::uint64_t>(*static_cast<const T*>(p)); }),
+                start(std::chrono::steady_clock::now())
+            {}
+
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            SolverTelemetry& telemetry;
+            const int& error;
+            const void* iterations;
+            std::uint64_t (*read_iterations)(const void*);
+            std::chrono::steady_clock::time_point start;
+        };
+
+        SolverTelemetry();
+        /// A copy starts with empty counters: it counts the calls of another solver.
+        SolverTelemetry(const SolverTelemetry&);
+        SolverTelemetry& operator=(const SolverTelemetry&) { return *this; }
+
+        /// Records a call without iterations.  Thread-safe.
+        void record(int error, std::uint64_t latency);
+        /// Records a call that ran \a iterations iterations.  Thread-safe.
+        void record(int error, std::uint64_t latency, std::uint64_t iterations);
+
+        /// Copies the counters to \a snapshot.  Lock-free, can be called from any thread.
+        void snapshot(Snapshot& snapshot) const;
+        Snapshot snapshot() const;
+
+        /// Clears the counters.
+        void reset();
+
+        /// Index of \a error in Snapshot::error_counts.
+        static std::size_t errorBin(int error);
+        static std::size_t latencyBin(std::uint64_t latency);
+        static std::size_t iterationBin(std::uint64_t iterations);
+
+    private:
+        void recordCall(int error, std::uint64_t latency);
+
+        typedef std::atomic<std::uint64_t> Counter;
+
+        Counter nr_of_calls;
+        Counter total_latency;
+        Counter max_latency;
+        Counter nr_of_iterated_calls;
+        Counter total_iterations;
+        Counter max_iterations;
+        std::array<Counter, NR_OF_LATENCY_BINS> latency_histogram;
+        std::array<Counter, NR_OF_ITERATION_BINS> iteration_histogram;
+        std::array<Counter, NR_OF_ERROR_BINS> error_counts;
+    };
+}
+
+#endif
@@ -0,0 +1,104 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "thread_pool.hpp"
+
+namespace KDL
+{
+    ThreadPool::ThreadPool(std::size_t nr_of_threads):
+        current_task(nullptr),
+        current_context(nullptr),
+        nr_of_tasks(0),
+        next_task(0),
+        busy(0),
+        generation(0),
+        stop(false)
+    {
+        if (nr_of_threads == 0)
+            nr_of_threads = std::thread::hardware_concurrency();
+        for (std::size_t i = 1; i < nr_of_threads; ++i)
+            workers.emplace_back(&ThreadPool::worker, this, i);
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        start_cv.notify_all();
+        for (std::size_t i = 0; i < workers.size(); ++i)
+            workers[i].join();
+    }
+
+    void ThreadPool::run(Task task, void* context, std::size_t n, std::size_t thread)
+    {
+        for (std::size_t i = next_task.fetch_add(1, std::memory_order_relaxed); i < n;
+             i = next_task.fetch_add(1, std::memory_order_relaxed))
+            task(context, i, thread);
+    }
+
+    void ThreadPool::worker(std::size_t thread)
+    {
+        std::uint64_t seen = 0;
+        for (;;) {
+            Task task;
+            void* context;
+            std::size_t n;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                start_cv.wait(lock, [&]{ return stop || generation != seen; });
+                if (stop)
+                    return;
+                seen = generation;
+                task = current_task;
+                context = current_context;
+                n = nr_of_tasks;
+            }
+            run(task, context, n, thread);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (--busy == 0)
+                    done_cv.notify_one();
+            }
+        }
+    }
+
+    void ThreadPool::parallel_for(std::size_t n, Task task, void* context)
+    {
+        if (n == 0)
+            return;
+        std::lock_guard<std::mutex> call_lock(call_mutex);
+        if (workers.empty() || n == 1) {
+            for (std::size_t i = 0; i < n; ++i)
+                task(context, i, 0);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            current_task = task;
+            current_context = context;
+            nr_of_tasks = n;
+            next_task.store(0, std::memory_order_relaxed);
+            busy = workers.size();
+            ++generation;
+        }
+        start_cv.notify_all();
+        run(task, context, n, 0);
+        std::unique_lock<std::mutex> lock(mutex);
+        done_cv.wait(lock, [&]{ return busy == 0; });
+    }
+}
@@ -0,0 +1,97 @@
+// Copyright  (C)  2026  Orocos KDL developers
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_THREAD_POOL_HPP
+#define KDL_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace KDL
+{
+    /**
+     * \brief Minimal fork-join thread pool used by the parallel solvers.
+     *
+     * The pool keeps its worker threads alive between calls, so that
+     * parallel_for does not create threads or allocate memory on the
+     * solver's hot path.  The calling thread takes part in the work: a
+     * pool of size n starts n-1 worker threads.
+     */
+    class ThreadPool
+    {
+    public:
+        /// Task callback: (context, task index, index of the executing thread in [0, size())).
+        typedef void (*Task)(void*, std::size_t, std::size_t);
+
+        /**
+         * \param nr_of_threads total number of threads taking part in
+         * parallel_for, including the caller. 0 selects
+         * std::thread::hardware_concurrency().
+         */
+        explicit ThreadPool(std::size_t nr_of_threads = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /// Number of threads executing tasks, including the caller.
+        std::size_t size() const { return workers.size() + 1; }
+
+        /**
+         * Executes task(i, thread) for all i in [0, n) and returns when all
+         * of them have finished.  Tasks are handed out dynamically, in
+         * increasing order of i.  Concurrent calls from several threads are
+         * serialized.
+         */
+        void parallel_for(std::size_t n, Task task, void* context);
+
+        /**
+         * Convenience overload for any callable f(task index, thread index).
+         * The callable is passed by reference, this does not allocate.
+         */
+        template <typename Function>
+        void parallel_for(std::size_t n, Function&& function)
+        {
+            typedef typename std::remove_reference<Function>::type F;
+            parallel_for(n, [](void* f, std::size_t i, std::size_t thread) { (*static_cast<F*>(f))(i, thread); },
+                         const_cast<void*>(static_cast<const void*>(&function)));
+        }
+
+    private:
+        void worker(std::size_t thread);
+        void run(Task task, void* context, std::size_t n, std::size_t thread);
+
+        std::vector<std::thread> workers;
+        std::mutex call_mutex;
+        std::mutex mutex;
+        std::condition_variable start_cv;
+        std::condition_variable done_cv;
+        Task current_task;
+        void* current_context;
+        std::size_t nr_of_tasks;
+        std::atomic<std::size_t> next_task;
+        std::size_t busy;
+        std::uint64_t generation;
+        bool stop;
+    };
+}
+
+#endif